@@ -4689,7 +4689,7 @@ add_newdoc('numpy.core', 'ufunc', ('signature',
 
 add_newdoc('numpy.core', 'ufunc', ('reduce',
     """
-    reduce(a, axis=0, dtype=None, out=None, keepdims=False, initial=<no value>, where=True)
+    reduce(a, axis=0, dtype=None, out=None, keepdims=False, initial=<no value>, where=True, *, compensated=False)
 
     Reduces `a`'s dimension by one, by applying ufunc along one axis.
 
@@ -4761,6 +4761,11 @@ add_newdoc('numpy.core', 'ufunc', ('reduce',
         defined, one has to pass in also ``initial``.
 
         .. versionadded:: 1.17.0
+    compensated : bool, optional
+        Only supported by `add`. If True, floating point and complex sums
+        are accumulated with Neumaier (compensated Kahan) summation, so
+        that the error does not grow with the number of elements. Other
+        dtypes and reductions using `where` are summed as usual.
 
     Returns
     -------
@@ -43,8 +43,9 @@ def _amin(a, axis=None, out=None, keepdims=False,
     return umr_minimum(a, axis, None, out, keepdims, initial, where)
 
 def _sum(a, axis=None, dtype=None, out=None, keepdims=False,
-         initial=_NoValue, where=True):
-    return umr_sum(a, axis, dtype, out, keepdims, initial, where)
+         initial=_NoValue, where=True, compensated=False):
+    return umr_sum(a, axis, dtype, out, keepdims, initial, where,
+                   compensated=compensated)
 
 def _prod(a, axis=None, dtype=None, out=None, keepdims=False,
           initial=_NoValue, where=True):
@@ -140,7 +141,8 @@ def _clip(a, min=None, max=None, out=None, *, casting=None, **kwargs):
         return _clip_dep_invoke_with_casting(
             um.clip, a, min, max, out=out, casting=casting, **kwargs)
 
-def _mean(a, axis=None, dtype=None, out=None, keepdims=False):
+def _mean(a, axis=None, dtype=None, out=None, keepdims=False,
+          compensated=False):
     arr = asanyarray(a)
 
     is_float16_result = False
@@ -157,7 +159,7 @@ def _mean(a, axis=None, dtype=None, out=None, keepdims=False):
             dtype = mu.dtype('f4')
             is_float16_result = True
 
-    ret = umr_sum(arr, axis, dtype, out, keepdims)
+    ret = umr_sum(arr, axis, dtype, out, keepdims, compensated=compensated)
     if isinstance(ret, mu.ndarray):
         ret = um.true_divide(
                 ret, rcount, out=ret, casting='unsafe', subok=False)
@@ -29,4 +29,37 @@
 #define npyv_cvt_b32_f32(BL) _mm256_castps_si256(BL)
 #define npyv_cvt_b64_f64(BL) _mm256_castpd_si256(BL)
 
+// convert double precision to single precision and vice versa
+NPY_FINLINE npyv_f32 npyv_pack_f32_f64(npyv_f64 a, npyv_f64 b)
+{
+    return _mm256_insertf128_ps(
+        _mm256_castps128_ps256(_mm256_cvtpd_ps(a)), _mm256_cvtpd_ps(b), 1
+    );
+}
+
+NPY_FINLINE npyv_f64x2 npyv_expand_f64_f32(npyv_f32 a)
+{
+    npyv_f64x2 r;
+    r.val[0] = _mm256_cvtps_pd(_mm256_castps256_ps128(a));
+    r.val[1] = _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1));
+    return r;
+}
+
+// expand unsigned 16-bit lanes to 32-bit and narrow them back (truncating)
+NPY_FINLINE npyv_u32x2 npyv_expand_u32_u16(npyv_u16 a)
+{
+    npyv_u32x2 r;
+    r.val[0] = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(a));
+    r.val[1] = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(a, 1));
+    return r;
+}
+
+NPY_FINLINE npyv_u16 npyv_pack_u16_u32(npyv_u32 a, npyv_u32 b)
+{
+    a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+    b = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+    // packs works within 128-bit lanes, restore the order of the halves
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
 #endif // _NPY_SIMD_AVX2_CVT_H
@@ -94,4 +94,33 @@ NPY_FINLINE npyv_f64x2 npyv_zip_f64(__m256d a, __m256d b)
     return npyv_combine_f64(ab0, ab1);
 }
 
+// reverse the byte order of each lane
+NPY_FINLINE npyv_u16 npyv_bswap_u16(npyv_u16 a)
+{
+    const __m256i idx = _mm256_setr_epi8(
+        1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14,
+        1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14
+    );
+    return _mm256_shuffle_epi8(a, idx);
+}
+NPY_FINLINE npyv_u32 npyv_bswap_u32(npyv_u32 a)
+{
+    const __m256i idx = _mm256_setr_epi8(
+        3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+        3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12
+    );
+    return _mm256_shuffle_epi8(a, idx);
+}
+NPY_FINLINE npyv_u64 npyv_bswap_u64(npyv_u64 a)
+{
+    const __m256i idx = _mm256_setr_epi8(
+        7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+        7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8
+    );
+    return _mm256_shuffle_epi8(a, idx);
+}
+#define npyv_bswap_s16 npyv_bswap_u16
+#define npyv_bswap_s32 npyv_bswap_u32
+#define npyv_bswap_s64 npyv_bswap_u64
+
 #endif // _NPY_SIMD_AVX2_REORDER_H
@@ -51,4 +51,28 @@
 #define npyv_cvt_b32_f32(A) npyv_cvt_b32_u32(_mm512_castps_si512(A))
 #define npyv_cvt_b64_f64(A) npyv_cvt_b64_u64(_mm512_castpd_si512(A))
 
+// convert double precision to single precision and vice versa
+NPY_FINLINE npyv_f32 npyv_pack_f32_f64(npyv_f64 a, npyv_f64 b)
+{ return npyv512_combine_ps256(_mm512_cvtpd_ps(a), _mm512_cvtpd_ps(b)); }
+
+NPY_FINLINE npyv_f64x2 npyv_expand_f64_f32(npyv_f32 a)
+{
+    npyv_f64x2 r;
+    r.val[0] = _mm512_cvtps_pd(npyv512_lower_ps256(a));
+    r.val[1] = _mm512_cvtps_pd(npyv512_higher_ps256(a));
+    return r;
+}
+
+// expand unsigned 16-bit lanes to 32-bit and narrow them back (truncating)
+NPY_FINLINE npyv_u32x2 npyv_expand_u32_u16(npyv_u16 a)
+{
+    npyv_u32x2 r;
+    r.val[0] = _mm512_cvtepu16_epi32(npyv512_lower_si256(a));
+    r.val[1] = _mm512_cvtepu16_epi32(npyv512_higher_si256(a));
+    return r;
+}
+
+NPY_FINLINE npyv_u16 npyv_pack_u16_u32(npyv_u32 a, npyv_u32 b)
+{ return npyv512_combine_si256(_mm512_cvtepi32_epi16(a), _mm512_cvtepi32_epi16(b)); }
+
 #endif // _NPY_SIMD_AVX512_CVT_H
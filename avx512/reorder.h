@@ -167,4 +167,54 @@ NPY_FINLINE npyv_f64x2 npyv_zip_f64(__m512d a, __m512d b)
     return r;
 }
 
+// reverse the byte order of each lane
+#ifdef NPY_HAVE_AVX512BW
+    NPY_FINLINE npyv_u16 npyv_bswap_u16(npyv_u16 a)
+    {
+        const __m512i idx = npyv_set_u8(
+            1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14,
+            1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14,
+            1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14,
+            1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14
+        );
+        return _mm512_shuffle_epi8(a, idx);
+    }
+    NPY_FINLINE npyv_u32 npyv_bswap_u32(npyv_u32 a)
+    {
+        const __m512i idx = npyv_set_u8(
+            3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+            3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+            3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+            3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12
+        );
+        return _mm512_shuffle_epi8(a, idx);
+    }
+    NPY_FINLINE npyv_u64 npyv_bswap_u64(npyv_u64 a)
+    {
+        const __m512i idx = npyv_set_u8(
+            7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+            7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+            7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+            7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8
+        );
+        return _mm512_shuffle_epi8(a, idx);
+    }
+#else
+    NPY_FINLINE npyv_u16 npyv_bswap_u16(npyv_u16 a)
+    {
+        const __m512i lo = _mm512_set1_epi32(0x00FF00FF);
+        return _mm512_or_si512(
+            _mm512_slli_epi32(_mm512_and_si512(a, lo), 8),
+            _mm512_srli_epi32(_mm512_andnot_si512(lo, a), 8)
+        );
+    }
+    NPY_FINLINE npyv_u32 npyv_bswap_u32(npyv_u32 a)
+    { return npyv_bswap_u16(_mm512_rol_epi32(a, 16)); }
+    NPY_FINLINE npyv_u64 npyv_bswap_u64(npyv_u64 a)
+    { return npyv_bswap_u32(_mm512_rol_epi64(a, 32)); }
+#endif
+#define npyv_bswap_s16 npyv_bswap_u16
+#define npyv_bswap_s32 npyv_bswap_u32
+#define npyv_bswap_s64 npyv_bswap_u64
+
 #endif // _NPY_SIMD_AVX512_REORDER_H
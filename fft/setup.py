@@ -10,7 +10,7 @@ def configuration(parent_package='',top_path=None):
     defs = [('_LARGE_FILES', None)] if sys.platform[:3] == "aix" else []
     # Configure pocketfft_internal
     config.add_extension('_pocketfft_internal',
-                         sources=['_pocketfft.c'],
+                         sources=['_pocketfft.c.src'],
                          define_macros=defs,
                          )
 
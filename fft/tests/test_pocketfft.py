@@ -219,6 +219,27 @@ class TestFFT1D:
                     assert_allclose(x_norm,
                                     np.linalg.norm(tmp), atol=1e-6)
 
+    @pytest.mark.parametrize("n", [1, 2, 7, 49, 97, 101, 211, 256, 1009, 1155])
+    def test_lengths(self, n):
+        # covers all butterflies, generic prime factors and, for the
+        # larger primes, Bluestein's algorithm
+        x = random(n) + 1j*random(n)
+        assert_allclose(fft1(x), np.fft.fft(x), atol=1e-9)
+        assert_allclose(np.fft.ifft(np.fft.fft(x)), x, atol=1e-12)
+        assert_allclose(np.fft.irfft(np.fft.rfft(x.real), n), x.real,
+                        atol=1e-12)
+
+    @pytest.mark.parametrize("rows", [1, 2, 3, 5, 8, 11, 17])
+    def test_many_rows(self, rows):
+        # several rows are transformed at once, check the leftover ones too
+        x = random((rows, 30)) + 1j*random((rows, 30))
+        expected = np.array([fft1(row) for row in x])
+        assert_allclose(np.fft.fft(x), expected, atol=1e-9)
+        assert_allclose(np.fft.rfft(x.real), np.fft.fft(x.real)[:, :16],
+                        atol=1e-9)
+        assert_allclose(np.fft.irfft(np.fft.rfft(x.real, 29), 29),
+                        x.real[:, :29], atol=1e-12)
+
     @pytest.mark.parametrize("dtype", [np.half, np.single, np.double,
                                        np.longdouble])
     def test_dtypes(self, dtype):
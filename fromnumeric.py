@@ -2109,13 +2109,13 @@ def clip(a, a_min, a_max, out=None, **kwargs):
 
 
 def _sum_dispatcher(a, axis=None, dtype=None, out=None, keepdims=None,
-                    initial=None, where=None):
+                    initial=None, where=None, compensated=None):
     return (a, out)
 
 
 @array_function_dispatch(_sum_dispatcher)
 def sum(a, axis=None, dtype=None, out=None, keepdims=np._NoValue,
-        initial=np._NoValue, where=np._NoValue):
+        initial=np._NoValue, where=np._NoValue, compensated=np._NoValue):
     """
     Sum of array elements over a given axis.
 
@@ -2164,6 +2164,12 @@ def sum(a, axis=None, dtype=None, out=None, keepdims=np._NoValue,
 
         .. versionadded:: 1.17.0
 
+    compensated : bool, optional
+        If True, floating point and complex sums use Neumaier (compensated
+        Kahan) summation, whose error does not grow with the number of
+        summed elements. It is slower than the default pairwise summation
+        and is ignored when `where` is given. See `~numpy.ufunc.reduce`.
+
     Returns
     -------
     sum_along_axis : ndarray
@@ -2197,15 +2203,14 @@ def sum(a, axis=None, dtype=None, out=None, keepdims=np._NoValue,
     For floating point numbers the numerical precision of sum (and
     ``np.add.reduce``) is in general limited by directly adding each number
     individually to the result causing rounding errors in every step.
-    However, often numpy will use a  numerically better approach (partial
-    pairwise summation) leading to improved precision in many use-cases.
-    This improved precision is always provided when no ``axis`` is given.
-    When ``axis`` is given, it will depend on which axis is summed.
-    Technically, to provide the best speed possible, the improved precision
-    is only used when the summation is along the fast axis in memory.
-    Note that the exact precision may vary depending on other parameters.
-    In contrast to NumPy, Python's ``math.fsum`` function uses a slower but
-    more precise approach to summation.
+    However, numpy uses a numerically better approach (partial pairwise
+    summation) leading to improved precision in many use-cases, whichever
+    axis is summed. The partial sums of very wide outputs and of inputs
+    that need casting are not blocked, so the exact precision may vary
+    depending on other parameters. ``compensated=True`` bounds the error
+    independently of the number of elements. In contrast to NumPy,
+    Python's ``math.fsum`` function uses a slower but exact approach to
+    summation.
     Especially when summing a large number of lower precision floating point
     numbers, such as ``float32``, numerical errors can become significant.
     In such cases it can be advisable to use `dtype="float64"` to use a higher
@@ -2250,7 +2255,7 @@ def sum(a, axis=None, dtype=None, out=None, keepdims=np._NoValue,
         return res
 
     return _wrapreduction(a, np.add, 'sum', axis, dtype, out, keepdims=keepdims,
-                          initial=initial, where=where)
+                          initial=initial, where=where, compensated=compensated)
 
 
 def _any_dispatcher(a, axis=None, out=None, keepdims=None):
@@ -3276,12 +3281,14 @@ def around(a, decimals=0, out=None):
     return _wrapfunc(a, 'round', decimals=decimals, out=out)
 
 
-def _mean_dispatcher(a, axis=None, dtype=None, out=None, keepdims=None):
+def _mean_dispatcher(a, axis=None, dtype=None, out=None, keepdims=None,
+                     compensated=None):
     return (a, out)
 
 
 @array_function_dispatch(_mean_dispatcher)
-def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue):
+def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue,
+         compensated=np._NoValue):
     """
     Compute the arithmetic mean along the specified axis.
 
@@ -3323,6 +3330,11 @@ def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue):
         sub-class' method does not implement `keepdims` any
         exceptions will be raised.
 
+    compensated : bool, optional
+        If True, the sum is computed with Neumaier (compensated Kahan)
+        summation, see `sum`. This is usually much faster than using a
+        `longdouble` accumulator.
+
     Returns
     -------
     m : ndarray, see dtype parameter above
@@ -3375,6 +3387,8 @@ def mean(a, axis=None, dtype=None, out=None, keepdims=np._NoValue):
     kwargs = {}
     if keepdims is not np._NoValue:
         kwargs['keepdims'] = keepdims
+    if compensated is not np._NoValue:
+        kwargs['compensated'] = compensated
     if type(a) is not mu.ndarray:
         try:
             mean = a.mean
@@ -50,6 +50,11 @@
 #define NPY_GCC_TARGET_FMA __attribute__((target("avx2,fma")))
 #endif
 
+#if defined HAVE_ATTRIBUTE_TARGET_F16C_WITH_INTRINSICS
+#define HAVE_ATTRIBUTE_TARGET_F16C
+#define NPY_GCC_TARGET_F16C __attribute__((target("avx,f16c")))
+#endif
+
 #if defined HAVE_ATTRIBUTE_TARGET_AVX2 && defined HAVE_LINK_AVX2
 #define NPY_GCC_TARGET_AVX2 __attribute__((target("avx2")))
 #else
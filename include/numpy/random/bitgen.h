@@ -8,12 +8,27 @@
 
 /* Must match the declaration in numpy/random/<any>.pxd */
 
+/*
+ * next_uint64_fill is optional and NULL when a bit generator does not
+ * provide it. When set, it writes the next cnt values that next_uint64
+ * would return, and next_double must be the top 53 bits of next_uint64
+ * scaled to [0, 1), so that bulk fills can be built on it.
+ *
+ * It was appended after the other members, so bitgen_t is one pointer
+ * larger than in NumPy 1.20. BitGenerator.__init__ sets it to NULL, which
+ * covers every subclass of BitGenerator, including ones compiled against
+ * the old header. Code that lays out a bitgen_t of its own and hands it
+ * to the distribution functions must set the member as well, to NULL if
+ * it has no bulk routine; the distribution functions check it for NULL
+ * before every use and then fall back to next_uint64.
+ */
 typedef struct bitgen {
   void *state;
   uint64_t (*next_uint64)(void *st);
   uint32_t (*next_uint32)(void *st);
   double (*next_double)(void *st);
   uint64_t (*next_raw)(void *st);
+  void (*next_uint64_fill)(void *st, size_t cnt, uint64_t *out);
 } bitgen_t;
 
 
@@ -59,10 +59,66 @@ typedef struct s_binomial_t {
   double p4;
 } binomial_t;
 
+/* Setup of the Poisson samplers for one rate */
+typedef struct s_poisson_t {
+  double lam;
+  double enlam;       /* exp(-lam), used for lam < 10 */
+  double loglam;      /* the rest is used for lam >= 10 */
+  double a, b, vr;
+  double loginvalpha;
+} poisson_t;
+
+/* Setup of the hypergeometric samplers for one set of parameters */
+typedef struct s_hypergeometric_t {
+  int64_t good, bad, sample;
+  int use_hrua;       /* the rest is set when use_hrua is nonzero */
+  int64_t computed_sample, mingoodbad, maxgoodbad;
+  double a, b, g, h;
+} hypergeometric_t;
+
+typedef struct s_mvnormal_t {
+  npy_intp dim;
+  int triangular;  /* factor is the lower triangular Cholesky factor */
+  double *mean;
+  double *factor;  /* dim x dim, variates are mean + factor z */
+} mvnormal_t;
+
+typedef struct s_alias_table {
+  npy_intp n;
+  double *prob;    /* probability of keeping the drawn column */
+  npy_intp *alias; /* index used otherwise */
+} alias_table;
+
+/*
+ * The seek interface of a bit generator, for block partitioned fills.
+ * copy_state returns an independent copy of a state, or NULL when out of
+ * memory, free_state releases such a copy and skip64 moves a state past
+ * its next cnt next_uint64 draws. Only bit generators with a cheap jump
+ * ahead, PCG64 and Philox, provide it.
+ */
+typedef struct s_bitgen_seek {
+  void *(*copy_state)(const void *st);
+  void (*free_state)(void *st);
+  void (*skip64)(void *st, uint64_t cnt);
+} bitgen_seek_t;
+
 DECLDIR float random_standard_uniform_f(bitgen_t *bitgen_state);
 DECLDIR double random_standard_uniform(bitgen_t *bitgen_state);
 DECLDIR void random_standard_uniform_fill(bitgen_t *, npy_intp, double *);
 DECLDIR void random_standard_uniform_fill_f(bitgen_t *, npy_intp, float *);
+/*
+ * Block partitioned random_standard_uniform_fill. Each block draws from a
+ * copy of the state seeked to its start, so the blocks can be filled on
+ * separate threads without the GIL and the result is the serial stream.
+ */
+DECLDIR int random_standard_uniform_fill_block(bitgen_t *bitgen_state,
+                                               const bitgen_seek_t *seek,
+                                               npy_intp start, npy_intp cnt,
+                                               double *out);
+DECLDIR int random_standard_uniform_fill_blocked(bitgen_t *bitgen_state,
+                                                 const bitgen_seek_t *seek,
+                                                 npy_intp block_size,
+                                                 npy_intp cnt, double *out);
 
 DECLDIR int64_t random_positive_int64(bitgen_t *bitgen_state);
 DECLDIR int32_t random_positive_int32(bitgen_t *bitgen_state);
@@ -124,6 +180,34 @@ DECLDIR RAND_INT_TYPE random_geometric(bitgen_t *bitgen_state, double p);
 DECLDIR RAND_INT_TYPE random_zipf(bitgen_t *bitgen_state, double a);
 DECLDIR int64_t random_hypergeometric(bitgen_t *bitgen_state,
                                       int64_t good, int64_t bad, int64_t sample);
+
+/* Samplers with their setup computed once, for repeated parameters */
+DECLDIR void random_poisson_setup(poisson_t *poisson, double lam);
+DECLDIR RAND_INT_TYPE random_poisson_prepared(bitgen_t *bitgen_state,
+                                              const poisson_t *poisson);
+DECLDIR void random_hypergeometric_setup(hypergeometric_t *hyper,
+                                         int64_t good, int64_t bad,
+                                         int64_t sample);
+DECLDIR int64_t random_hypergeometric_prepared(bitgen_t *bitgen_state,
+                                               const hypergeometric_t *hyper);
+
+/* Parameter arrays with out[i] drawn using the parameters at index[i] */
+DECLDIR int random_poisson_indexed_fill(bitgen_t *bitgen_state,
+                                        npy_intp nparam, const double *lam,
+                                        npy_intp cnt, const npy_intp *index,
+                                        RAND_INT_TYPE *out);
+DECLDIR int random_binomial_indexed_fill(bitgen_t *bitgen_state,
+                                         npy_intp nparam, const double *p,
+                                         const int64_t *n, npy_intp cnt,
+                                         const npy_intp *index, int64_t *out);
+DECLDIR int random_hypergeometric_indexed_fill(bitgen_t *bitgen_state,
+                                               npy_intp nparam,
+                                               const int64_t *good,
+                                               const int64_t *bad,
+                                               const int64_t *sample,
+                                               npy_intp cnt,
+                                               const npy_intp *index,
+                                               int64_t *out);
 DECLDIR uint64_t random_interval(bitgen_t *bitgen_state, uint64_t max);
 
 /* Generate random uint64 numbers in closed interval [off, off + rng]. */
@@ -155,6 +239,19 @@ DECLDIR void random_bounded_uint64_fill(bitgen_t *bitgen_state, uint64_t off,
 DECLDIR void random_bounded_uint32_fill(bitgen_t *bitgen_state, uint32_t off,
                                         uint32_t rng, npy_intp cnt,
                                         bool use_masked, uint32_t *out);
+/*
+ * Opt-in variants of the two fills above. For ranges that fit in 32 bits
+ * they draw through next_uint64_fill and use both halves of each draw,
+ * so their stream differs from that of the next_uint32 based fills.
+ */
+DECLDIR void random_bounded_uint64_fill_fast(bitgen_t *bitgen_state,
+                                             uint64_t off, uint64_t rng,
+                                             npy_intp cnt, bool use_masked,
+                                             uint64_t *out);
+DECLDIR void random_bounded_uint32_fill_fast(bitgen_t *bitgen_state,
+                                             uint32_t off, uint32_t rng,
+                                             npy_intp cnt, bool use_masked,
+                                             uint32_t *out);
 DECLDIR void random_bounded_uint16_fill(bitgen_t *bitgen_state, uint16_t off,
                                         uint16_t rng, npy_intp cnt,
                                         bool use_masked, uint16_t *out);
@@ -182,6 +279,34 @@ DECLDIR void random_multivariate_hypergeometric_marginals(bitgen_t *bitgen_state
                                    int64_t nsample,
                                    size_t num_variates, int64_t *variates);
 
+/* weighted sampling with replacement through an alias table */
+DECLDIR int random_alias_table_init(alias_table *table, npy_intp n,
+                                    const double *p);
+DECLDIR void random_alias_table_free(alias_table *table);
+DECLDIR void random_alias_fill(bitgen_t *bitgen_state, const alias_table *table,
+                               npy_intp cnt, int64_t *out);
+
+/* weighted sampling without replacement */
+DECLDIR int random_weighted_sample_noreplace(bitgen_t *bitgen_state, npy_intp n,
+                                             const double *p, npy_intp k,
+                                             int64_t *out);
+
+/* multivariate normal with a factorization kept across calls */
+DECLDIR int random_mvnormal_init(mvnormal_t *mvn, npy_intp dim,
+                                 const double *mean, const double *cov,
+                                 double tol);
+DECLDIR void random_mvnormal_free(mvnormal_t *mvn);
+DECLDIR int random_mvnormal_fill(bitgen_t *bitgen_state, const mvnormal_t *mvn,
+                                 npy_intp cnt, double *out);
+DECLDIR int random_mvnormal_stack_fill(bitgen_t *bitgen_state, npy_intp nstack,
+                                       npy_intp dim, const double *mean,
+                                       const double *cov, double tol,
+                                       npy_intp cnt, double *out);
+
+/* cache blocked in-place shuffle of n contiguous items */
+DECLDIR int random_shuffle_blocked(bitgen_t *bitgen_state, char *data,
+                                   npy_intp n, npy_intp itemsize);
+
 /* Common to legacy-distributions.c and distributions.c but not exported */
 
 RAND_INT_TYPE random_binomial_btpe(bitgen_t *bitgen_state,
@@ -2,6 +2,7 @@
  * NOTE: This is generated code. Look in numpy/linalg/lapack_lite for
  *       information on remaking this file.
  */
+#define LAPACK_LITE_REFERENCE_BLAS
 #include "f2c.h"
 
 #ifdef HAVE_CONFIG
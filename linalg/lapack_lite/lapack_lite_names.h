@@ -127,7 +127,6 @@
 #define dgelq2_ BLAS_FUNC(dgelq2)
 #define dgelqf_ BLAS_FUNC(dgelqf)
 #define dgelsd_ BLAS_FUNC(dgelsd)
-#define dgemm_ BLAS_FUNC(dgemm)
 #define dgemv_ BLAS_FUNC(dgemv)
 #define dgeqr2_ BLAS_FUNC(dgeqr2)
 #define dgeqrf_ BLAS_FUNC(dgeqrf)
@@ -249,14 +248,12 @@
 #define dsymv_ BLAS_FUNC(dsymv)
 #define dsyr2_ BLAS_FUNC(dsyr2)
 #define dsyr2k_ BLAS_FUNC(dsyr2k)
-#define dsyrk_ BLAS_FUNC(dsyrk)
 #define dsytd2_ BLAS_FUNC(dsytd2)
 #define dsytrd_ BLAS_FUNC(dsytrd)
 #define dtrevc_ BLAS_FUNC(dtrevc)
 #define dtrexc_ BLAS_FUNC(dtrexc)
 #define dtrmm_ BLAS_FUNC(dtrmm)
 #define dtrmv_ BLAS_FUNC(dtrmv)
-#define dtrsm_ BLAS_FUNC(dtrsm)
 #define dtrti2_ BLAS_FUNC(dtrti2)
 #define dtrtri_ BLAS_FUNC(dtrtri)
 #define dzasum_ BLAS_FUNC(dzasum)
@@ -295,7 +292,6 @@
 #define sgelq2_ BLAS_FUNC(sgelq2)
 #define sgelqf_ BLAS_FUNC(sgelqf)
 #define sgelsd_ BLAS_FUNC(sgelsd)
-#define sgemm_ BLAS_FUNC(sgemm)
 #define sgemv_ BLAS_FUNC(sgemv)
 #define sgeqr2_ BLAS_FUNC(sgeqr2)
 #define sgeqrf_ BLAS_FUNC(sgeqrf)
@@ -417,14 +413,12 @@
 #define ssymv_ BLAS_FUNC(ssymv)
 #define ssyr2_ BLAS_FUNC(ssyr2)
 #define ssyr2k_ BLAS_FUNC(ssyr2k)
-#define ssyrk_ BLAS_FUNC(ssyrk)
 #define ssytd2_ BLAS_FUNC(ssytd2)
 #define ssytrd_ BLAS_FUNC(ssytrd)
 #define strevc_ BLAS_FUNC(strevc)
 #define strexc_ BLAS_FUNC(strexc)
 #define strmm_ BLAS_FUNC(strmm)
 #define strmv_ BLAS_FUNC(strmv)
-#define strsm_ BLAS_FUNC(strsm)
 #define strti2_ BLAS_FUNC(strti2)
 #define strtri_ BLAS_FUNC(strtri)
 #define xerbla_ BLAS_FUNC(xerbla)
@@ -533,6 +527,32 @@
 #define zunmqr_ BLAS_FUNC(zunmqr)
 #define zunmtr_ BLAS_FUNC(zunmtr)
 
+/*
+ * Level-3 routines replaced by blas_blocked.c.src; the f2c versions in
+ * f2c_blas.c are built under the *_reference names instead.
+ */
+#ifdef LAPACK_LITE_REFERENCE_BLAS
+#define dgemm_ dgemm_reference_
+#define dsyrk_ dsyrk_reference_
+#define dtrsm_ dtrsm_reference_
+#define sgemm_ sgemm_reference_
+#define ssyrk_ ssyrk_reference_
+#define strsm_ strsm_reference_
+#else
+#define dgemm_ BLAS_FUNC(dgemm)
+#define dsyrk_ BLAS_FUNC(dsyrk)
+#define dtrsm_ BLAS_FUNC(dtrsm)
+#define sgemm_ BLAS_FUNC(sgemm)
+#define ssyrk_ BLAS_FUNC(ssyrk)
+#define strsm_ BLAS_FUNC(strsm)
+#endif
+#define dgemm_reference_ BLAS_FUNC(dgemm_reference)
+#define dsyrk_reference_ BLAS_FUNC(dsyrk_reference)
+#define dtrsm_reference_ BLAS_FUNC(dtrsm_reference)
+#define sgemm_reference_ BLAS_FUNC(sgemm_reference)
+#define ssyrk_reference_ BLAS_FUNC(ssyrk_reference)
+#define strsm_reference_ BLAS_FUNC(strsm_reference)
+
 /* Symbols exported by f2c.c */
 #define abort_ numpy_lapack_lite_abort_
 #define c_abs numpy_lapack_lite_c_abs
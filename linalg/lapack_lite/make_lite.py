@@ -62,6 +62,13 @@ them.
 #endif
 '''
 
+# Level-3 BLAS routines replaced by the cache blocked versions in
+# blas_blocked.c.src. f2c_blas.c still builds them, but as *_reference_,
+# which the blocked routines fall back to.
+BLOCKED_BLAS = ['dgemm', 'dsyrk', 'dtrsm', 'sgemm', 'ssyrk', 'strsm']
+
+REFERENCE_BLAS_DEFINE = '#define LAPACK_LITE_REFERENCE_BLAS\n'
+
 class FortranRoutine:
     """Wrapper for a Fortran routine in a file.
     """
@@ -269,7 +276,11 @@ def scrubF2CSource(c_file):
         source = fo.read()
     source = clapack_scrub.scrubSource(source, verbose=True)
     with open(c_file, 'w') as fo:
-        fo.write(HEADER)
+        if os.path.basename(c_file) == 'f2c_blas.c':
+            fo.write(HEADER.replace('#include "f2c.h"',
+                                    REFERENCE_BLAS_DEFINE + '#include "f2c.h"'))
+        else:
+            fo.write(HEADER)
         fo.write(source)
 
 def ensure_executable(name):
@@ -315,8 +326,25 @@ def create_name_header(output_dir):
             " */\n")
 
         # Rename BLAS/LAPACK symbols
-        for name in sorted(symbols):
+        for name in sorted(symbols - set(BLOCKED_BLAS)):
+            f.write("#define %s_ BLAS_FUNC(%s)\n" % (name, name))
+
+        # The f2c versions of the blocked routines become *_reference_
+        f.write("\n"
+                "/*\n"
+                " * Level-3 routines replaced by blas_blocked.c.src; the f2c versions in\n"
+                " * f2c_blas.c are built under the *_reference names instead.\n"
+                " */\n"
+                "#ifdef LAPACK_LITE_REFERENCE_BLAS\n")
+        for name in BLOCKED_BLAS:
+            f.write("#define %s_ %s_reference_\n" % (name, name))
+        f.write("#else\n")
+        for name in BLOCKED_BLAS:
             f.write("#define %s_ BLAS_FUNC(%s)\n" % (name, name))
+        f.write("#endif\n")
+        for name in BLOCKED_BLAS:
+            f.write("#define %s_reference_ BLAS_FUNC(%s_reference)\n"
+                    % (name, name))
 
         # Rename also symbols that f2c exports itself
         f.write("\n"
@@ -24,7 +24,7 @@ from numpy.core import (
     add, multiply, sqrt, fastCopyAndTranspose, sum, isfinite,
     finfo, errstate, geterrobj, moveaxis, amin, amax, product, abs,
     atleast_2d, intp, asanyarray, object_, matmul,
-    swapaxes, divide, count_nonzero, isnan, sign, argsort, sort
+    swapaxes, divide, count_nonzero, isnan, sign, argsort, sort, hypot, where
 )
 from numpy.core.multiarray import normalize_axis_index
 from numpy.core.overrides import set_module
@@ -211,6 +211,101 @@ def _is_empty_2d(arr):
     # check size first for efficiency
     return arr.size == 0 and product(arr.shape[-2:]) == 0
 
+# Stacks of 2x2 and 3x3 matrices are evaluated in closed form over the
+# whole stack. Through LAPACK every one of them costs a gufunc inner loop
+# iteration, a copy into Fortran order and a factorization, which for
+# matrices this small is far more work than the arithmetic itself.
+#
+# The cofactor expansion is only as accurate as pivoted LU while the
+# matrix is well conditioned, so inv and det still hand the matrices with
+# a 1-norm condition number above 1/sqrt(eps), singular ones included, to
+# LAPACK. A stack thus gives the same results for those as the matrices
+# on their own, and results within rounding error for all others. Single
+# matrices always go through LAPACK, where the overhead does not matter.
+def _is_small_stack(a, sizes=(2, 3)):
+    return a.ndim > 2 and a.shape[-1] in sizes and a.size > 0
+
+def _small_adjugate(a):
+    adj = empty_like(a)
+    if a.shape[-1] == 2:
+        adj[..., 0, 0] = a[..., 1, 1]
+        adj[..., 0, 1] = -a[..., 0, 1]
+        adj[..., 1, 0] = -a[..., 1, 0]
+        adj[..., 1, 1] = a[..., 0, 0]
+        return adj
+    for i in range(3):
+        i1, i2 = (i + 1) % 3, (i + 2) % 3
+        for j in range(3):
+            # cofactor of a[j, i], the cyclic indices carry its sign
+            j1, j2 = (j + 1) % 3, (j + 2) % 3
+            adj[..., i, j] = (a[..., j1, i1] * a[..., j2, i2] -
+                              a[..., j1, i2] * a[..., j2, i1])
+    return adj
+
+def _small_adjugate_det(a):
+    """Adjugates and determinants, and where LAPACK has to take over"""
+    adj = _small_adjugate(a)
+    # expansion along the first row, reusing the cofactors
+    det = sum(a[..., 0, :] * adj[..., :, 0], axis=-1)
+    # inv(a) = adj / det, so this is the exact reciprocal condition
+    # number; written as a negation so that nan and inf fall back too
+    anorm = abs(a).sum(axis=-2).max(axis=-1)
+    adjnorm = abs(adj).sum(axis=-2).max(axis=-1)
+    rcond = sqrt(finfo(det.dtype).eps)
+    lapack = ~(abs(det) > rcond * anorm * adjnorm)
+    return adj, det, lapack
+
+def _small_det(a, signature):
+    _, det, lapack = _small_adjugate_det(a)
+    if lapack.any():
+        det[lapack] = _umath_linalg.det(a[lapack], signature=signature)
+    return det
+
+def _small_inv(a, signature, extobj):
+    adj, det, lapack = _small_adjugate_det(a)
+    det[lapack] = 1
+    ainv = adj / det[..., newaxis, newaxis]
+    if lapack.any():
+        ainv[lapack] = _umath_linalg.inv(a[lapack], signature=signature,
+                                         extobj=extobj)
+    return ainv
+
+def _small_eigh(a, UPLO, compute_v):
+    # Only the UPLO triangle is referenced, as in LAPACK. With b the
+    # element below the diagonal the matrix is [[p, conj(b)], [b, q]],
+    # whose eigenvalues are m -+ r with m = (p + q)/2 and
+    # r = hypot((p - q)/2, |b|).
+    p = a[..., 0, 0].real
+    q = a[..., 1, 1].real
+    b = a[..., 1, 0] if UPLO == 'L' else a[..., 0, 1].conj()
+    h = (p - q) / 2
+    r = hypot(h, abs(b))
+    m = (p + q) / 2
+    w = empty(a.shape[:-1], dtype=p.dtype)
+    w[..., 0] = m - r
+    w[..., 1] = m + r
+    if not compute_v:
+        return w, None
+
+    # Eigenvector of m + r from whichever row of (A - (m + r) I) is
+    # better conditioned, the other one is orthogonal to it.
+    x = (h >= 0)
+    v0 = where(x, h + r, b.conj())
+    v1 = where(x, b, r - h)
+    nrm = hypot(abs(v0), abs(v1))
+    # a multiple of the identity, any basis will do
+    degenerate = (nrm == 0)
+    v0 = v0 + degenerate
+    nrm = nrm + degenerate
+    v0 = v0 / nrm
+    v1 = v1 / nrm
+    v = empty_like(a)
+    v[..., 0, 0] = -v1.conj()
+    v[..., 1, 0] = v0.conj()
+    v[..., 0, 1] = v0
+    v[..., 1, 1] = v1
+    return w, v
+
 
 def transpose(a):
     """
@@ -542,6 +637,10 @@ def inv(a):
 
     signature = 'D->D' if isComplexType(t) else 'd->d'
     extobj = get_linalg_error_extobj(_raise_linalgerror_singular)
+    if _is_small_stack(a):
+        ainv = _small_inv(a.astype(t, copy=False), signature, extobj)
+        return wrap(ainv.astype(result_t, copy=False))
+
     ainv = _umath_linalg.inv(a, signature=signature, extobj=extobj)
     return wrap(ainv.astype(result_t, copy=False))
 
@@ -1171,6 +1270,9 @@ def eigvalsh(a, UPLO='L'):
     _assert_stacked_2d(a)
     _assert_stacked_square(a)
     t, result_t = _commonType(a)
+    if _is_small_stack(a, sizes=(2,)):
+        w, _ = _small_eigh(a.astype(t, copy=False), UPLO, compute_v=False)
+        return w.astype(_realType(result_t), copy=False)
     signature = 'D->d' if isComplexType(t) else 'd->d'
     w = gufunc(a, signature=signature, extobj=extobj)
     return w.astype(_realType(result_t), copy=False)
@@ -1459,6 +1561,12 @@ def eigh(a, UPLO='L'):
     _assert_stacked_square(a)
     t, result_t = _commonType(a)
 
+    if _is_small_stack(a, sizes=(2,)):
+        w, vt = _small_eigh(a.astype(t, copy=False), UPLO, compute_v=True)
+        w = w.astype(_realType(result_t), copy=False)
+        vt = vt.astype(result_t, copy=False)
+        return w, wrap(vt)
+
     extobj = get_linalg_error_extobj(
         _raise_linalgerror_eigenvalues_nonconvergence)
     if UPLO == 'L':
@@ -2155,6 +2263,9 @@ def det(a):
     _assert_stacked_square(a)
     t, result_t = _commonType(a)
     signature = 'D->D' if isComplexType(t) else 'd->d'
+    if _is_small_stack(a):
+        r = _small_det(a.astype(t, copy=False), signature)
+        return r.astype(result_t, copy=False)
     r = _umath_linalg.det(a, signature=signature)
     r = r.astype(result_t, copy=False)
     return r
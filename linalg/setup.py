@@ -25,6 +25,7 @@ def configuration(parent_package='', top_path=None):
         os.path.join(src_dir, 'f2c_s_lapack.c'),
         os.path.join(src_dir, 'f2c_lapack.c'),
         os.path.join(src_dir, 'f2c_blas.c'),
+        os.path.join(src_dir, 'blas_blocked.c.src'),
         os.path.join(src_dir, 'f2c_config.c'),
         os.path.join(src_dir, 'f2c.c'),
     ]
@@ -69,6 +70,7 @@ def configuration(parent_package='', top_path=None):
         'lapack_lite',
         sources=['lapack_litemodule.c', get_lapack_lite_sources],
         depends=['lapack_lite/f2c.h'],
+        include_dirs=[src_dir],
         extra_info=lapack_info,
     )
 
@@ -77,6 +79,7 @@ def configuration(parent_package='', top_path=None):
         '_umath_linalg',
         sources=['umath_linalg.c.src', get_lapack_lite_sources],
         depends=['lapack_lite/f2c.h'],
+        include_dirs=[src_dir],
         extra_info=lapack_info,
         libraries=['npymath'],
     )
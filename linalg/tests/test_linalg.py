@@ -518,6 +518,16 @@ class TestSolve(SolveCases):
         assert_array_equal(result, expected)
         assert_(isinstance(result, ArraySubclass))
 
+    @pytest.mark.parametrize('dtype', [single, double])
+    @pytest.mark.parametrize('n, nrhs', [(150, 1), (301, 77)])
+    def test_large(self, dtype, n, nrhs):
+        # large enough for the blocked level-3 routines of lapack_lite
+        rng = np.random.RandomState(7)
+        a = rng.randn(n, n).astype(dtype) + n * np.eye(n, dtype=dtype)
+        b = rng.randn(n, nrhs).astype(dtype)
+        x = linalg.solve(a, b)
+        assert_allclose(a @ x, b, atol=100 * n * np.finfo(dtype).eps)
+
 
 class InvCases(LinalgSquareTestCase, LinalgGeneralizedSquareTestCase):
 
@@ -1787,6 +1797,70 @@ def test_generalized_raise_multiloop():
     assert_raises(np.linalg.LinAlgError, np.linalg.inv, x)
 
 
+class TestSmallStacks:
+    # stacks of 2x2 and 3x3 matrices are evaluated in closed form, check
+    # them against the LAPACK results for the individual matrices
+
+    @pytest.mark.parametrize('n', [2, 3])
+    @pytest.mark.parametrize('dtype', [single, double, csingle, cdouble])
+    def test_inv_det(self, n, dtype):
+        rng = np.random.RandomState(3)
+        a = rng.randn(5, 4, n, n) + n * np.eye(n)
+        if issubclass(dtype, np.complexfloating):
+            a = a + 1j * rng.randn(5, 4, n, n)
+        a = a.astype(dtype)
+        rtol = 1e-5 if dtype in (single, csingle) else 1e-12
+
+        ainv = linalg.inv(a)
+        adet = linalg.det(a)
+        assert_equal(ainv.dtype, dtype)
+        assert_equal(adet.dtype, dtype)
+        for idx in np.ndindex(a.shape[:-2]):
+            assert_allclose(ainv[idx], linalg.inv(a[idx]), rtol=rtol)
+            assert_allclose(adet[idx], linalg.det(a[idx]), rtol=rtol)
+
+    def test_inv_singular(self):
+        a = np.tile(np.eye(3), (4, 1, 1))
+        a[2, 1] = a[2, 0]
+        assert_raises(LinAlgError, linalg.inv, a)
+
+    def test_ill_conditioned(self):
+        # singular and ill-conditioned matrices are left to LAPACK, so a
+        # stack gives the same results for them as the matrices alone
+        for a in [np.arange(1., 10.).reshape(3, 3),
+                  np.array([[1., 2.], [2., 4. + 1e-12]]),
+                  np.array([[1., 2., 3.], [4., 5., 6.], [7., 8., 9. + 1e-9]])]:
+            stack = np.stack([np.eye(len(a)), a])
+            assert_equal(linalg.det(stack)[1], linalg.det(a))
+            try:
+                expected = linalg.inv(a)
+            except LinAlgError:
+                assert_raises(LinAlgError, linalg.inv, stack)
+            else:
+                assert_equal(linalg.inv(stack)[1], expected)
+
+    @pytest.mark.parametrize('UPLO', ['L', 'U'])
+    @pytest.mark.parametrize('dtype', [single, double, csingle, cdouble])
+    def test_eigh(self, UPLO, dtype):
+        rng = np.random.RandomState(4)
+        a = rng.randn(50, 2, 2)
+        if issubclass(dtype, np.complexfloating):
+            a = a + 1j * rng.randn(50, 2, 2)
+        a[:3] = 0
+        a[3:6, 0, 1] = a[3:6, 1, 0] = 0
+        a = a.astype(dtype)
+        atol = 1e-5 if dtype in (single, csingle) else 1e-12
+
+        w, v = linalg.eigh(a, UPLO)
+        assert_allclose(w, linalg.eigvalsh(a, UPLO), atol=atol)
+        for idx in range(a.shape[0]):
+            assert_allclose(w[idx], linalg.eigvalsh(a[idx], UPLO), atol=atol)
+            h = np.tril(a[idx]) if UPLO == 'L' else np.triu(a[idx])
+            h = h + h.conj().T - np.diag(np.diag(h).real)
+            assert_allclose(h @ v[idx], v[idx] * w[idx], atol=10 * atol)
+            assert_allclose(v[idx].conj().T @ v[idx], np.eye(2), atol=atol)
+
+
 def test_xerbla_override():
     # Check that our xerbla has been successfully linked in. If it is not,
     # the default xerbla routine is called, which prints a message to stdout
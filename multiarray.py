@@ -31,9 +31,9 @@ __all__ = [
     'compare_chararrays', 'concatenate', 'copyto', 'correlate', 'correlate2',
     'count_nonzero', 'c_einsum', 'datetime_as_string', 'datetime_data',
     'digitize', 'dot', 'dragon4_positional', 'dragon4_scientific', 'dtype',
-    'empty', 'empty_like', 'error', 'flagsobj', 'flatiter', 'format_longfloat',
-    'frombuffer', 'fromfile', 'fromiter', 'fromstring', 'inner',
-    'interp', 'interp_complex', 'is_busday', 'lexsort',
+    'empty', 'empty_like', 'error', 'filter_columns', 'flagsobj', 'flatiter',
+    'format_longfloat', 'frombuffer', 'fromfile', 'fromiter', 'fromstring',
+    'inner', 'interp', 'interp_complex', 'is_busday', 'lexsort',
     'matmul', 'may_share_memory', 'min_scalar_type', 'ndarray', 'nditer',
     'nested_iters', 'normalize_axis_index', 'packbits',
     'promote_types', 'putmask', 'ravel_multi_index', 'result_type', 'scalar',
@@ -383,6 +383,63 @@ def where(condition, x=None, y=None):
     return (condition, x, y)
 
 
+@array_function_from_c_func_and_dispatcher(_multiarray_umath.filter_columns)
+def filter_columns(predicates, targets=None):
+    """
+    filter_columns(predicates, targets=None)
+
+    Select the rows for which all of a set of comparisons hold.
+
+    ``filter_columns([(a, '>', 3), (b, '<', 5)], [x, y])`` gives the same
+    result as ``(x[m], y[m])`` with ``m = (a > 3) & (b < 5)``, but never
+    creates the boolean arrays. The comparisons are evaluated a block of
+    rows at a time, and only one bit per row is kept for the second pass
+    that gathers the selected rows.
+
+    Parameters
+    ----------
+    predicates : sequence of (array_like, str, scalar)
+        Tuples ``(column, op, value)`` of a 1-D column, one of the operators
+        ``'<'``, ``'<='``, ``'=='``, ``'!='``, ``'>'`` and ``'>='``, and the
+        value it is compared with. All columns must have the same length.
+        Integer and floating point columns are supported, compared in the
+        type that ``column op value`` would use.
+    targets : sequence of array_like, optional
+        Arrays whose rows along the first axis are selected. Each must
+        have as many rows as the columns have entries.
+
+    Returns
+    -------
+    out : tuple of ndarray or ndarray
+        The selected rows of every target in order or, if `targets` is not
+        given, the indices of the rows for which all predicates hold.
+
+    See Also
+    --------
+    compress, nonzero
+
+    Examples
+    --------
+    >>> a = np.arange(10)
+    >>> b = np.array([1., 7., 2., 8., 3., 9., 4., 0., 5., 6.])
+    >>> np.core.multiarray.filter_columns([(a, '>', 3), (b, '<', 5)])
+    array([6, 7])
+    >>> np.core.multiarray.filter_columns([(a, '>', 3), (b, '<', 5)],
+    ...                                   [a, 10 * b])
+    (array([6, 7]), array([40.,  0.]))
+    """
+    # Only lists and tuples are looked into, so that an iterator is not
+    # used up here; the implementation refuses it and reports malformed
+    # predicates itself.
+    relevant = []
+    if isinstance(predicates, (list, tuple)):
+        relevant.extend(pred[0] for pred in predicates
+                        if isinstance(pred, tuple) and len(pred) == 3)
+    if isinstance(targets, (list, tuple)):
+        relevant.extend(targets)
+    return relevant
+
+
 @array_function_from_c_func_and_dispatcher(_multiarray_umath.lexsort)
 def lexsort(keys, axis=None):
     """
@@ -367,6 +367,19 @@ _strided_byte_swap(void *p, npy_intp stride, npy_intp n, int size)
     char *a, *b, c = 0;
     int j, m;
 
+    /*
+     * Contiguous data of a basic size is swapped in-place by the
+     * vectorized copy-swap loops.
+     */
+    if (stride == size && (size == 2 || size == 4 || size == 8)) {
+        PyArray_StridedUnaryOp *swapfn = PyArray_GetStridedCopySwapFn(
+                0, stride, stride, size);
+        if (swapfn != NULL) {
+            swapfn(p, stride, p, stride, n, size, NULL);
+            return;
+        }
+    }
+
     switch(size) {
     case 1: /* no byteswap necessary */
         break;
@@ -27,6 +27,7 @@
 #include "alloc.h"
 #include "arraytypes.h"
 #include "array_coercion.h"
+#include "item_selection.h"
 
 
 static NPY_GCC_OPT_3 NPY_INLINE int
@@ -37,12 +38,28 @@ npy_fasttake_impl(
         NPY_CLIPMODE clipmode, npy_intp itemsize, int needs_refcounting,
         PyArray_Descr *dtype, int axis)
 {
+    /* Aligned 4 and 8 byte chunks are gathered by the vectorized kernels */
+    int fastgather = (!needs_refcounting && (chunk == 4 || chunk == 8) &&
+                      npy_is_aligned(src, chunk) &&
+                      npy_is_aligned(dest, chunk));
+
     NPY_BEGIN_THREADS_DEF;
     NPY_BEGIN_THREADS_DESCR(dtype);
     switch (clipmode) {
         case NPY_RAISE:
             for (npy_intp i = 0; i < n; i++) {
-                for (npy_intp j = 0; j < m; j++) {
+                npy_intp j = 0;
+                if (fastgather) {
+                    /* The loop below reports an invalid index if any */
+                    if (chunk == 4) {
+                        j = npy_fastgather_4(dest, src, indices, m, max_item);
+                    }
+                    else {
+                        j = npy_fastgather_8(dest, src, indices, m, max_item);
+                    }
+                    dest += j * chunk;
+                }
+                for (; j < m; j++) {
                     npy_intp tmp = indices[j];
                     if (check_and_adjust_index(&tmp, max_item, axis,
                                                _save) < 0) {
@@ -428,7 +445,20 @@ PyArray_PutTo(PyArrayObject *self, PyObject* values0, PyObject *indices0,
         NPY_BEGIN_THREADS_THRESHOLDED(ni);
         switch(clipmode) {
         case NPY_RAISE:
-            for (i = 0; i < ni; i++) {
+            i = 0;
+            if (nv >= ni && (chunk == 4 || chunk == 8) &&
+                    npy_is_aligned(dest, chunk)) {
+                /* Scatter, the loop below reports an invalid index if any */
+                if (chunk == 4) {
+                    i = npy_fastscatter_4(dest, PyArray_BYTES(values),
+                                          PyArray_DATA(indices), ni, max_item);
+                }
+                else {
+                    i = npy_fastscatter_8(dest, PyArray_BYTES(values),
+                                          PyArray_DATA(indices), ni, max_item);
+                }
+            }
+            for (; i < ni; i++) {
                 src = PyArray_BYTES(values) + chunk * (i % nv);
                 tmp = ((npy_intp *)(PyArray_DATA(indices)))[i];
                 if (check_and_adjust_index(&tmp, max_item, 0, _save) < 0) {
@@ -2065,6 +2095,39 @@ PyArray_Compress(PyArrayObject *self, PyObject *condition, int axis,
         return NULL;
     }
 
+    /* Pack contiguous 4 and 8 byte items directly, without the indices */
+    if (out == NULL && PyArray_CheckExact(self) && PyArray_NDIM(self) == 1 &&
+            (axis == 0 || axis == -1 || axis == NPY_MAXDIMS) &&
+            PyArray_ISBOOL(cond) && PyArray_IS_C_CONTIGUOUS(cond) &&
+            PyArray_DIM(cond, 0) == PyArray_DIM(self, 0) &&
+            PyArray_IS_C_CONTIGUOUS(self) && IsUintAligned(self) &&
+            (PyArray_ITEMSIZE(self) == 4 || PyArray_ITEMSIZE(self) == 8) &&
+            !PyDataType_REFCHK(PyArray_DESCR(self))) {
+        npy_intp n = PyArray_DIM(self, 0);
+        npy_intp size = count_boolean_trues(1, PyArray_DATA(cond),
+                                            PyArray_DIMS(cond),
+                                            PyArray_STRIDES(cond));
+        NPY_BEGIN_THREADS_DEF;
+
+        Py_INCREF(PyArray_DESCR(self));
+        ret = PyArray_NewFromDescr(&PyArray_Type, PyArray_DESCR(self),
+                                   1, &size, NULL, NULL, 0, NULL);
+        if (ret != NULL) {
+            NPY_BEGIN_THREADS_THRESHOLDED(n);
+            if (PyArray_ITEMSIZE(self) == 4) {
+                npy_compress_4(PyArray_DATA((PyArrayObject *)ret), size,
+                               PyArray_DATA(self), PyArray_DATA(cond), n);
+            }
+            else {
+                npy_compress_8(PyArray_DATA((PyArrayObject *)ret), size,
+                               PyArray_DATA(self), PyArray_DATA(cond), n);
+            }
+            NPY_END_THREADS;
+        }
+        Py_DECREF(cond);
+        return ret;
+    }
+
     res = PyArray_Nonzero(cond);
     Py_DECREF(cond);
     if (res == NULL) {
@@ -2076,6 +2139,358 @@ PyArray_Compress(PyArrayObject *self, PyObject *condition, int axis,
     return ret;
 }
 
+/* Number of rows for which the predicates are evaluated at once */
+#define NPY_FILTER_BLOCK 4096
+
+/* Converts '<', '<=', '==', '!=', '>', '>=' to Py_LT ... Py_GE or -1 */
+static int
+filter_comparison_op(PyObject *op)
+{
+    static const char *const names[6] = {"<", "<=", "==", "!=", ">", ">="};
+    static const int ops[6] = {Py_LT, Py_LE, Py_EQ, Py_NE, Py_GT, Py_GE};
+    const char *s;
+    int i;
+
+    if (!PyUnicode_Check(op)) {
+        return -1;
+    }
+    s = PyUnicode_AsUTF8(op);
+    if (s == NULL) {
+        PyErr_Clear();
+        return -1;
+    }
+    for (i = 0; i < 6; i++) {
+        if (strcmp(s, names[i]) == 0) {
+            return ops[i];
+        }
+    }
+    return -1;
+}
+
+/* Packs the m entries of mask into bits, returning the number set */
+static npy_intp
+filter_pack_bits(const npy_bool *mask, npy_intp m, npy_uint8 *bits)
+{
+    npy_intp i, k, count = 0;
+
+    for (i = 0; i < m; i += 8) {
+        const npy_intp len = PyArray_MIN(m - i, 8);
+        npy_uint8 byte = 0;
+        for (k = 0; k < len; k++) {
+            byte |= (npy_uint8)(mask[i + k] << k);
+            count += mask[i + k];
+        }
+        bits[i / 8] = byte;
+    }
+    return count;
+}
+
+static void
+filter_unpack_bits(const npy_uint8 *bits, npy_intp m, npy_bool *mask)
+{
+    npy_intp i, k;
+
+    for (i = 0; i < m; i += 8) {
+        const npy_intp len = PyArray_MIN(m - i, 8);
+        const npy_uint8 byte = bits[i / 8];
+        for (k = 0; k < len; k++) {
+            mask[i + k] = (byte >> k) & 1;
+        }
+    }
+}
+
+/* Copies the rows of src selected by the m entries of mask to dst */
+static void
+filter_copy_rows(char *dst, npy_intp dst_len, const char *src,
+                 npy_intp rowsize, const npy_bool *mask, npy_intp m)
+{
+    npy_intp i;
+
+    if (rowsize == 4 && npy_is_aligned(src, 4) && npy_is_aligned(dst, 4)) {
+        npy_compress_4(dst, dst_len, src, mask, m);
+        return;
+    }
+    if (rowsize == 8 && npy_is_aligned(src, 8) && npy_is_aligned(dst, 8)) {
+        npy_compress_8(dst, dst_len, src, mask, m);
+        return;
+    }
+    for (i = 0; i < m; i++) {
+        if (mask[i]) {
+            memcpy(dst, src + i * rowsize, rowsize);
+            dst += rowsize;
+        }
+    }
+}
+
+/*
+ * Selects the rows for which all (column, op, value) predicates hold.
+ * The predicates are evaluated a block of rows at a time into a mask that
+ * stays in cache, and only the combined result is kept, as one bit per
+ * row. A second pass copies the selected rows of every target, or writes
+ * their indices if there are no targets, once the output sizes are known.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_FilterColumns(PyObject *predicates, PyObject *targets)
+{
+    PyObject *preds = NULL, *tgts = NULL, *ret = NULL;
+    PyArrayObject **arrays = NULL, **columns, **values, **inputs, **outputs;
+    PyArray_PredicateFunc **funcs = NULL;
+    npy_intp *rowsizes = NULL, *block_counts = NULL;
+    npy_uint8 *bits = NULL;
+    npy_bool mask[NPY_FILTER_BLOCK];
+    npy_intp npred, ntarget = 0, narrays, n = -1;
+    npy_intp nblocks, total = 0, written, i, b;
+    int needs_api = 0;
+    NPY_BEGIN_THREADS_DEF;
+
+    /*
+     * Iterators are refused rather than read, as the __array_function__
+     * dispatcher would already have used them up.
+     */
+    if (!PySequence_Check(predicates) || (targets != NULL &&
+            targets != Py_None && !PySequence_Check(targets))) {
+        PyErr_SetString(PyExc_TypeError,
+                "filter_columns: predicates and targets must be sequences");
+        return NULL;
+    }
+    preds = PySequence_Fast(predicates,
+                            "filter_columns: predicates must be a sequence");
+    if (preds == NULL) {
+        return NULL;
+    }
+    npred = PySequence_Fast_GET_SIZE(preds);
+    if (npred == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "filter_columns: at least one predicate is required");
+        goto finish;
+    }
+    if (targets != NULL && targets != Py_None) {
+        tgts = PySequence_Fast(targets,
+                               "filter_columns: targets must be a sequence");
+        if (tgts == NULL) {
+            goto finish;
+        }
+        ntarget = PySequence_Fast_GET_SIZE(tgts);
+    }
+
+    narrays = 2 * npred + 2 * ntarget;
+    arrays = PyArray_malloc(narrays * sizeof(PyArrayObject *));
+    funcs = PyArray_malloc(npred * sizeof(PyArray_PredicateFunc *));
+    rowsizes = PyArray_malloc((ntarget + 1) * sizeof(npy_intp));
+    if (arrays == NULL || funcs == NULL || rowsizes == NULL) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+    memset(arrays, 0, narrays * sizeof(PyArrayObject *));
+    columns = arrays;
+    values = columns + npred;
+    inputs = values + npred;
+    outputs = inputs + ntarget;
+
+    for (i = 0; i < npred; i++) {
+        PyObject *pred = PySequence_Fast_GET_ITEM(preds, i);
+        PyArrayObject *both[2] = {NULL, NULL};
+        PyArray_Descr *dtype;
+        int op;
+
+        if (!PyTuple_Check(pred) || PyTuple_GET_SIZE(pred) != 3) {
+            PyErr_SetString(PyExc_ValueError,
+                    "filter_columns: predicates must be "
+                    "(column, op, value) tuples");
+            goto finish;
+        }
+        op = filter_comparison_op(PyTuple_GET_ITEM(pred, 1));
+        if (op < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "filter_columns: op must be one of "
+                    "'<', '<=', '==', '!=', '>' and '>='");
+            goto finish;
+        }
+        both[0] = (PyArrayObject *)PyArray_FROM_O(PyTuple_GET_ITEM(pred, 0));
+        if (both[0] != NULL) {
+            both[1] = (PyArrayObject *)PyArray_FROM_O(
+                                            PyTuple_GET_ITEM(pred, 2));
+        }
+        if (both[1] == NULL) {
+            Py_XDECREF(both[0]);
+            goto finish;
+        }
+        if (PyArray_NDIM(both[0]) != 1 || PyArray_NDIM(both[1]) != 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "filter_columns: columns must be 1-d and values scalars");
+            Py_DECREF(both[0]);
+            Py_DECREF(both[1]);
+            goto finish;
+        }
+        /* Compare in the common type, casting the column if needed */
+        dtype = PyArray_ResultType(2, both, 0, NULL);
+        if (dtype != NULL && dtype->type_num == NPY_HALF) {
+            /* half precision is compared exactly as float */
+            Py_SETREF(dtype, PyArray_DescrFromType(NPY_FLOAT));
+        }
+        funcs[i] = dtype == NULL ? NULL :
+                   npy_get_predicate_function(dtype->type_num, op);
+        if (dtype != NULL && funcs[i] == NULL) {
+            PyErr_Format(PyExc_TypeError,
+                    "filter_columns: comparisons of %S are not supported",
+                    (PyObject *)dtype);
+        }
+        if (funcs[i] != NULL) {
+            Py_INCREF(dtype);
+            columns[i] = (PyArrayObject *)PyArray_FromArray(both[0], dtype,
+                                                NPY_ARRAY_ALIGNED);
+            Py_INCREF(dtype);
+            values[i] = (PyArrayObject *)PyArray_FromArray(both[1], dtype,
+                                NPY_ARRAY_ALIGNED | NPY_ARRAY_FORCECAST);
+        }
+        Py_XDECREF(dtype);
+        Py_DECREF(both[0]);
+        Py_DECREF(both[1]);
+        if (columns[i] == NULL || values[i] == NULL) {
+            goto finish;
+        }
+        if (n < 0) {
+            n = PyArray_DIM(columns[i], 0);
+        }
+        else if (PyArray_DIM(columns[i], 0) != n) {
+            PyErr_SetString(PyExc_ValueError,
+                    "filter_columns: all columns must have the same length");
+            goto finish;
+        }
+    }
+
+    for (i = 0; i < ntarget; i++) {
+        PyArrayObject *target = (PyArrayObject *)PyArray_FROM_OF(
+                PySequence_Fast_GET_ITEM(tgts, i), NPY_ARRAY_CARRAY_RO);
+        if (target == NULL) {
+            goto finish;
+        }
+        inputs[i] = target;
+        if (PyArray_NDIM(target) == 0 || PyArray_DIM(target, 0) != n) {
+            PyErr_SetString(PyExc_ValueError,
+                    "filter_columns: targets must have the same length "
+                    "as the columns");
+            goto finish;
+        }
+        rowsizes[i] = PyArray_ITEMSIZE(target) * PyArray_MultiplyList(
+                PyArray_DIMS(target) + 1, PyArray_NDIM(target) - 1);
+        needs_api |= PyDataType_REFCHK(PyArray_DESCR(target));
+    }
+
+    nblocks = (n + NPY_FILTER_BLOCK - 1) / NPY_FILTER_BLOCK;
+    bits = PyArray_malloc((n + 7) / 8 + 1);
+    block_counts = PyArray_malloc((nblocks + 1) * sizeof(npy_intp));
+    if (bits == NULL || block_counts == NULL) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+
+    /* First pass, the combined predicate of every row */
+    NPY_BEGIN_THREADS_THRESHOLDED(n);
+    for (b = 0; b < nblocks; b++) {
+        const npy_intp start = b * NPY_FILTER_BLOCK;
+        const npy_intp m = PyArray_MIN(n - start, NPY_FILTER_BLOCK);
+
+        for (i = 0; i < npred; i++) {
+            const npy_intp stride = PyArray_STRIDE(columns[i], 0);
+            funcs[i](PyArray_BYTES(columns[i]) + start * stride, stride, m,
+                     PyArray_BYTES(values[i]), mask, i == 0);
+        }
+        block_counts[b] = filter_pack_bits(mask, m,
+                                           bits + start / 8);
+        total += block_counts[b];
+    }
+    NPY_END_THREADS;
+
+    /* Allocate the outputs, an empty tuple for an empty list of targets */
+    if (tgts == NULL) {
+        ret = PyArray_NewFromDescr(&PyArray_Type,
+                                   PyArray_DescrFromType(NPY_INTP),
+                                   1, &total, NULL, NULL, 0, NULL);
+        if (ret == NULL) {
+            goto finish;
+        }
+    }
+    else {
+        ret = PyTuple_New(ntarget);
+        if (ret == NULL) {
+            goto finish;
+        }
+        for (i = 0; i < ntarget; i++) {
+            npy_intp dims[NPY_MAXDIMS];
+            PyArray_Descr *dtype = PyArray_DESCR(inputs[i]);
+
+            memcpy(dims, PyArray_DIMS(inputs[i]),
+                   PyArray_NDIM(inputs[i]) * sizeof(npy_intp));
+            dims[0] = total;
+            Py_INCREF(dtype);
+            outputs[i] = (PyArrayObject *)PyArray_NewFromDescr(
+                    &PyArray_Type, dtype, PyArray_NDIM(inputs[i]), dims,
+                    NULL, NULL, 0, NULL);
+            if (outputs[i] == NULL) {
+                Py_CLEAR(ret);
+                goto finish;
+            }
+            Py_INCREF(outputs[i]);
+            PyTuple_SET_ITEM(ret, i, (PyObject *)outputs[i]);
+        }
+    }
+
+    /* Second pass, copy the selected rows */
+    if (!needs_api) {
+        NPY_BEGIN_THREADS_THRESHOLDED(n);
+    }
+    for (b = 0, written = 0; b < nblocks; b++) {
+        const npy_intp start = b * NPY_FILTER_BLOCK;
+        const npy_intp m = PyArray_MIN(n - start, NPY_FILTER_BLOCK);
+
+        if (block_counts[b] == 0) {
+            continue;
+        }
+        filter_unpack_bits(bits + start / 8, m, mask);
+        if (tgts == NULL) {
+            npy_intp *dst = (npy_intp *)PyArray_DATA((PyArrayObject *)ret);
+            npy_intp k;
+
+            dst += written;
+            npy_compress_indices(dst, total - written, mask, m);
+            for (k = 0; k < block_counts[b]; k++) {
+                dst[k] += start;
+            }
+        }
+        for (i = 0; i < ntarget; i++) {
+            filter_copy_rows(PyArray_BYTES(outputs[i]) + written * rowsizes[i],
+                             total - written,
+                             PyArray_BYTES(inputs[i]) + start * rowsizes[i],
+                             rowsizes[i], mask, m);
+        }
+        written += block_counts[b];
+    }
+    NPY_END_THREADS;
+
+    /* The object references were copied as they are */
+    for (i = 0; i < ntarget; i++) {
+        if (PyDataType_REFCHK(PyArray_DESCR(outputs[i]))) {
+            PyArray_INCREF(outputs[i]);
+        }
+    }
+
+finish:
+    if (arrays != NULL) {
+        for (i = 0; i < narrays; i++) {
+            Py_XDECREF(arrays[i]);
+        }
+    }
+    PyArray_free(arrays);
+    PyArray_free(funcs);
+    PyArray_free(rowsizes);
+    PyArray_free(bits);
+    PyArray_free(block_counts);
+    Py_XDECREF(preds);
+    Py_XDECREF(tgts);
+    return ret;
+}
+
 /*
  * count number of nonzero bytes in 48 byte block
  * w must be aligned to 8 bytes
@@ -2414,7 +2829,12 @@ PyArray_Nonzero(PyArrayObject *self)
         }
 
         /* avoid function call for bool */
-        if (is_bool) {
+        if (is_bool && stride == 1) {
+            /* packs a vector of indices at a time, skipping false blocks */
+            npy_compress_indices(multi_index, nonzero_count,
+                                 (npy_bool *)data, count);
+        }
+        else if (is_bool) {
             /*
              * use fast memchr variant for sparse data, see gh-4370
              * the fast bool count is followed by this sparse path is faster
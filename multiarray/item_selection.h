@@ -27,4 +27,79 @@ NPY_NO_EXPORT int
 PyArray_MultiIndexSetItem(PyArrayObject *self, const npy_intp *multi_index,
                                                 PyObject *obj);
 
+/*
+ * Gather dst[i] = src[ind[i]] and scatter dst[ind[i]] = src[i] of n
+ * aligned, contiguous 4 or 8 byte items, with max_item items indexed.
+ * Negative indices count from the end. Both stop before the first index
+ * that is out of bounds and return the number of items copied, so that
+ * the caller can report that index. Defined in lowlevel_strided_loops.c.src.
+ */
+NPY_NO_EXPORT npy_intp
+npy_fastgather_4(char *dst, const char *src,
+                 const npy_intp *ind, npy_intp n, npy_intp max_item);
+NPY_NO_EXPORT npy_intp
+npy_fastgather_8(char *dst, const char *src,
+                 const npy_intp *ind, npy_intp n, npy_intp max_item);
+NPY_NO_EXPORT npy_intp
+npy_fastscatter_4(char *dst, const char *src,
+                  const npy_intp *ind, npy_intp n, npy_intp max_item);
+NPY_NO_EXPORT npy_intp
+npy_fastscatter_8(char *dst, const char *src,
+                  const npy_intp *ind, npy_intp n, npy_intp max_item);
+
+/*
+ * Copy the items src[j] of n contiguous, aligned 4 or 8 byte items for
+ * which mask[j] is nonzero to dst, or write those indices j to dst for
+ * npy_compress_indices. dst has room for dst_len items, which must be
+ * at least their number. Returns the number of items written. Defined
+ * in lowlevel_strided_loops.c.src.
+ */
+NPY_NO_EXPORT npy_intp
+npy_compress_4(char *dst, npy_intp dst_len, const char *src,
+               const npy_bool *mask, npy_intp n);
+NPY_NO_EXPORT npy_intp
+npy_compress_8(char *dst, npy_intp dst_len, const char *src,
+               const npy_bool *mask, npy_intp n);
+NPY_NO_EXPORT npy_intp
+npy_compress_indices(npy_intp *dst, npy_intp dst_len,
+                     const npy_bool *mask, npy_intp n);
+
+/*
+ * Patterns of index arrays found by npy_index_pattern, defined in
+ * lowlevel_strided_loops.c.src. All but NPY_INDEX_RANDOM imply that
+ * the indices are in bounds and not negative.
+ */
+#define NPY_INDEX_RANDOM 0
+#define NPY_INDEX_SORTED 1
+#define NPY_INDEX_STRIDED 2
+#define NPY_INDEX_RUNS 3
+
+NPY_NO_EXPORT int
+npy_index_pattern(const npy_intp *ind, npy_intp n, npy_intp max_item,
+                  npy_intp *pstep);
+
+/*
+ * Compares the n items of col, which are stride bytes apart, with the
+ * scalar at value and stores the result in mask, or ands it into mask
+ * unless first is set. Both operands are of the same native type.
+ */
+typedef void (PyArray_PredicateFunc)(const char *col, npy_intp stride,
+                                     npy_intp n, const char *value,
+                                     npy_bool *mask, int first);
+
+/*
+ * Returns the predicate for the comparison cmp_op (Py_LT ... Py_GE) of
+ * type_num, or NULL if there is none. Defined in
+ * lowlevel_strided_loops.c.src.
+ */
+NPY_NO_EXPORT PyArray_PredicateFunc *
+npy_get_predicate_function(int type_num, int cmp_op);
+
+/*
+ * Selects the rows for which all (column, op, value) predicates hold,
+ * see numpy.core.multiarray.filter_columns.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_FilterColumns(PyObject *predicates, PyObject *targets);
+
 #endif
@@ -1047,6 +1047,7 @@ array_boolean_subscript(PyArrayObject *self,
         npy_intp self_stride, bmask_stride, subloopsize;
         char *self_data;
         char *bmask_data;
+        int fastcompress;
         NPY_BEGIN_THREADS_DEF;
 
         /* Set up the iterator */
@@ -1091,11 +1092,29 @@ array_boolean_subscript(PyArrayObject *self,
 
         self_stride = innerstrides[0];
         bmask_stride = innerstrides[1];
+        /* Contiguous 4 and 8 byte items are packed by vectorized kernels */
+        fastcompress = (!needs_api && IsUintAligned(self) &&
+                        (itemsize == 4 || itemsize == 8) &&
+                        self_stride == itemsize && bmask_stride == 1);
         do {
             innersize = *NpyIter_GetInnerLoopSizePtr(iter);
             self_data = dataptrs[0];
             bmask_data = dataptrs[1];
 
+            if (fastcompress) {
+                npy_intp room, copied;
+                room = size - (ret_data - PyArray_BYTES(ret)) / itemsize;
+                if (itemsize == 4) {
+                    copied = npy_compress_4(ret_data, room, self_data,
+                                        (npy_bool *)bmask_data, innersize);
+                }
+                else {
+                    copied = npy_compress_8(ret_data, room, self_data,
+                                        (npy_bool *)bmask_data, innersize);
+                }
+                ret_data += copied * itemsize;
+                continue;
+            }
             while (innersize > 0) {
                 /* Skip masked values */
                 bmask_data = npy_memchr(bmask_data, 0, bmask_stride,
@@ -2510,7 +2529,7 @@ PyArray_MapIterCheckIndices(PyArrayMapIterObject *mit)
                 IsUintAligned(op) &&
                 PyDataType_ISNOTSWAPPED(PyArray_DESCR(op))) {
             char *data;
-            npy_intp stride;
+            npy_intp stride, step;
             /* release GIL if it was taken by nditer below */
             if (_save == NULL) {
                 NPY_BEGIN_THREADS;
@@ -2518,6 +2537,12 @@ PyArray_MapIterCheckIndices(PyArrayMapIterObject *mit)
 
             PyArray_PREPARE_TRIVIAL_ITERATION(op, itersize, data, stride);
 
+            /* Sorted and strided indices are known to be in bounds */
+            if (stride == sizeof(npy_intp) &&
+                    npy_index_pattern((npy_intp *)data, itersize,
+                                      outer_dim, &step) != NPY_INDEX_RANDOM) {
+                continue;
+            }
             while (itersize--) {
                 indval = *((npy_intp*)data);
                 if (check_and_adjust_index(&indval,
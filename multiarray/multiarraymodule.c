@@ -3101,6 +3101,20 @@ array_where(PyObject *NPY_UNUSED(ignored), PyObject *args)
     return PyArray_Where(obj, x, y);
 }
 
+static PyObject *
+array_filter_columns(PyObject *NPY_UNUSED(ignored), PyObject *args,
+                     PyObject *kwds)
+{
+    PyObject *predicates, *targets = NULL;
+    static char *kwlist[] = {"predicates", "targets", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O:filter_columns", kwlist,
+                                     &predicates, &targets)) {
+        return NULL;
+    }
+    return PyArray_FilterColumns(predicates, targets);
+}
+
 static PyObject *
 array_lexsort(PyObject *NPY_UNUSED(ignored), PyObject *args, PyObject *kwds)
 {
@@ -3993,6 +4007,9 @@ static struct PyMethodDef array_module_methods[] = {
     {"where",
         (PyCFunction)array_where,
         METH_VARARGS, NULL},
+    {"filter_columns",
+        (PyCFunction)array_filter_columns,
+        METH_VARARGS|METH_KEYWORDS, NULL},
     {"lexsort",
         (PyCFunction)array_lexsort,
         METH_VARARGS | METH_KEYWORDS, NULL},
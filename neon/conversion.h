@@ -29,4 +29,30 @@
 #define npyv_cvt_b32_f32(BL) vreinterpretq_u32_f32(BL)
 #define npyv_cvt_b64_f64(BL) vreinterpretq_u64_f64(BL)
 
+// convert double precision to single precision and vice versa
+#if NPY_SIMD_F64
+NPY_FINLINE npyv_f32 npyv_pack_f32_f64(npyv_f64 a, npyv_f64 b)
+{ return vcvt_high_f32_f64(vcvt_f32_f64(a), b); }
+
+NPY_FINLINE npyv_f64x2 npyv_expand_f64_f32(npyv_f32 a)
+{
+    npyv_f64x2 r;
+    r.val[0] = vcvt_f64_f32(vget_low_f32(a));
+    r.val[1] = vcvt_high_f64_f32(a);
+    return r;
+}
+#endif // NPY_SIMD_F64
+
+// expand unsigned 16-bit lanes to 32-bit and narrow them back (truncating)
+NPY_FINLINE npyv_u32x2 npyv_expand_u32_u16(npyv_u16 a)
+{
+    npyv_u32x2 r;
+    r.val[0] = vmovl_u16(vget_low_u16(a));
+    r.val[1] = vmovl_u16(vget_high_u16(a));
+    return r;
+}
+
+NPY_FINLINE npyv_u16 npyv_pack_u16_u32(npyv_u32 a, npyv_u32 b)
+{ return vcombine_u16(vmovn_u32(a), vmovn_u32(b)); }
+
 #endif // _NPY_SIMD_NEON_CVT_H
@@ -107,4 +107,12 @@ NPYV_IMPL_NEON_COMBINE(npyv_f64, f64)
 #define npyv_zip_u64 npyv_combine_u64
 #define npyv_zip_s64 npyv_combine_s64
 
+// reverse the byte order of each lane
+#define npyv_bswap_u16(A) vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(A)))
+#define npyv_bswap_s16(A) vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(A)))
+#define npyv_bswap_u32(A) vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(A)))
+#define npyv_bswap_s32(A) vreinterpretq_s32_u8(vrev32q_u8(vreinterpretq_u8_s32(A)))
+#define npyv_bswap_u64(A) vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(A)))
+#define npyv_bswap_s64(A) vreinterpretq_s64_u8(vrev64q_u8(vreinterpretq_u8_s64(A)))
+
 #endif // _NPY_SIMD_NEON_REORDER_H
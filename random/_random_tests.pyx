@@ -0,0 +1,425 @@
+#!python
+#cython: wraparound=False, nonecheck=False, boundscheck=False, cdivision=True, language_level=3
+"""
+Test only wrappers of npyrandom and bit generator routines that the
+Python API does not reach directly. Used by tests/test_npyrandom.py.
+"""
+import numpy as np
+
+from cpython.pycapsule cimport PyCapsule_GetPointer
+cimport numpy as np
+
+from libc.stdint cimport int64_t, uint32_t, uint64_t
+from numpy cimport npy_intp
+from numpy.random cimport bitgen_t
+from .c_distributions cimport (random_standard_uniform_fill,
+        bitgen_seek_t, random_standard_uniform_fill_block,
+        random_standard_uniform_fill_blocked,
+        random_standard_normal_fill, random_standard_exponential_fill,
+        random_bounded_uint64_fill_fast, random_bounded_uint32_fill_fast,
+        alias_table, random_alias_table_init, random_alias_table_free,
+        random_alias_fill, random_weighted_sample_noreplace,
+        random_shuffle_blocked, random_poisson_indexed_fill,
+        random_binomial_indexed_fill, random_hypergeometric_indexed_fill,
+        mvnormal_t, random_mvnormal_init, random_mvnormal_free,
+        random_mvnormal_fill, random_mvnormal_stack_fill)
+
+np.import_array()
+
+cdef extern from "numpy/random/distributions.h":
+    void random_bounded_uint64_fill(bitgen_t *bitgen_state, uint64_t off,
+                                    uint64_t rng, npy_intp cnt,
+                                    bint use_masked, uint64_t *out) nogil
+
+cdef extern from "src/pcg64/pcg64.h":
+    ctypedef struct pcg64_state:
+        pass
+    void pcg64_fill64(pcg64_state *state, size_t cnt, uint64_t *out) nogil
+    void pcg64_skip64(pcg64_state *state, uint64_t cnt) nogil
+    pcg64_state *pcg64_copy_state(const pcg64_state *state) nogil
+    void pcg64_free_state(pcg64_state *state) nogil
+
+cdef extern from "src/philox/philox.h":
+    ctypedef struct philox_state:
+        pass
+    void philox_fill64(philox_state *state, size_t cnt, uint64_t *out) nogil
+    void philox_skip64(philox_state *state, uint64_t cnt) nogil
+    philox_state *philox_copy_state(const philox_state *state) nogil
+    void philox_free_state(philox_state *state) nogil
+
+cdef extern from "src/sfc64/sfc64.h":
+    ctypedef struct sfc64_state:
+        pass
+    void sfc64_fill64(sfc64_state *state, size_t cnt, uint64_t *out) nogil
+
+ctypedef void (*fill64_func)(void *st, size_t cnt, uint64_t *out) nogil
+ctypedef void (*double_fill_func)(bitgen_t *bitgen_state, npy_intp cnt,
+                                 double *out) nogil
+
+
+cdef bitgen_t *_bitgen(bit_generator) except NULL:
+    return <bitgen_t *>PyCapsule_GetPointer(bit_generator.capsule,
+                                            "BitGenerator")
+
+
+cdef fill64_func _fill64(bit_generator) except NULL:
+    name = type(bit_generator).__name__
+    if name == 'PCG64':
+        return <fill64_func>&pcg64_fill64
+    elif name == 'Philox':
+        return <fill64_func>&philox_fill64
+    elif name == 'SFC64':
+        return <fill64_func>&sfc64_fill64
+    raise ValueError(f'no bulk fill for {name}')
+
+
+def fill64(bit_generator, npy_intp cnt):
+    """The next cnt values of bit_generator through its bulk fill"""
+    cdef bitgen_t *bitgen = _bitgen(bit_generator)
+    cdef fill64_func fill = _fill64(bit_generator)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.uint64)
+    cdef uint64_t *out_data = <uint64_t *>np.PyArray_DATA(out)
+
+    with bit_generator.lock, nogil:
+        fill(bitgen.state, cnt, out_data)
+    return out
+
+
+def skip64(bit_generator, uint64_t cnt):
+    """Advances bit_generator past its next cnt 64-bit outputs"""
+    cdef bitgen_t *bitgen = _bitgen(bit_generator)
+    name = type(bit_generator).__name__
+
+    with bit_generator.lock:
+        if name == 'PCG64':
+            pcg64_skip64(<pcg64_state *>bitgen.state, cnt)
+        elif name == 'Philox':
+            philox_skip64(<philox_state *>bitgen.state, cnt)
+        else:
+            raise ValueError(f'no skip for {name}')
+
+
+cdef bitgen_seek_t _seek(bit_generator) except *:
+    cdef bitgen_seek_t seek
+    name = type(bit_generator).__name__
+    if name == 'PCG64':
+        seek.copy_state = <void *(*)(const void *) nogil>&pcg64_copy_state
+        seek.free_state = <void (*)(void *) nogil>&pcg64_free_state
+        seek.skip64 = <void (*)(void *, uint64_t) nogil>&pcg64_skip64
+    elif name == 'Philox':
+        seek.copy_state = <void *(*)(const void *) nogil>&philox_copy_state
+        seek.free_state = <void (*)(void *) nogil>&philox_free_state
+        seek.skip64 = <void (*)(void *, uint64_t) nogil>&philox_skip64
+    else:
+        raise ValueError(f'no seek for {name}')
+    return seek
+
+
+def standard_uniform_fill_blocked(bit_generator, npy_intp cnt,
+                                  npy_intp block_size):
+    """random_standard_uniform_fill_blocked with the bulk fill"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, True)
+    cdef bitgen_seek_t seek = _seek(bit_generator)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.float64)
+    cdef double *out_data = <double *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with bit_generator.lock, nogil:
+        ret = random_standard_uniform_fill_blocked(&bitgen, &seek, block_size,
+                                                   cnt, out_data)
+    if ret < 0:
+        raise MemoryError()
+    return out
+
+
+def standard_uniform_fill_block(bit_generator, np.ndarray out,
+                                npy_intp start):
+    """random_standard_uniform_fill_block into the float64 array out,
+    without the lock, as a thread filling one block would call it"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, True)
+    cdef bitgen_seek_t seek = _seek(bit_generator)
+    cdef npy_intp cnt = np.PyArray_SIZE(out)
+    cdef double *out_data = <double *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with nogil:
+        ret = random_standard_uniform_fill_block(&bitgen, &seek, start, cnt,
+                                                 out_data)
+    if ret < 0:
+        raise MemoryError()
+
+
+cdef bitgen_t _with_fill(bit_generator, bint bulk):
+    # a copy of the bitgen_t, with the bulk fill installed the way the bit
+    # generators do it, or cleared
+    cdef bitgen_t bitgen = _bitgen(bit_generator)[0]
+    bitgen.next_uint64_fill = _fill64(bit_generator) if bulk else NULL
+    return bitgen
+
+
+cdef object _double_fill(double_fill_func func, bit_generator, npy_intp cnt,
+                         bint bulk):
+    cdef bitgen_t bitgen = _with_fill(bit_generator, bulk)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.float64)
+    cdef double *out_data = <double *>np.PyArray_DATA(out)
+
+    with bit_generator.lock, nogil:
+        func(&bitgen, cnt, out_data)
+    return out
+
+
+def standard_uniform_fill(bit_generator, npy_intp cnt, bint bulk):
+    """random_standard_uniform_fill with or without the bulk fill"""
+    return _double_fill(&random_standard_uniform_fill, bit_generator, cnt,
+                        bulk)
+
+
+def standard_normal_fill(bit_generator, npy_intp cnt, bint bulk):
+    """random_standard_normal_fill with or without the bulk fill"""
+    return _double_fill(&random_standard_normal_fill, bit_generator, cnt,
+                        bulk)
+
+
+def standard_exponential_fill(bit_generator, npy_intp cnt, bint bulk):
+    """random_standard_exponential_fill with or without the bulk fill"""
+    return _double_fill(&random_standard_exponential_fill, bit_generator,
+                        cnt, bulk)
+
+
+def bounded_uint64_fill(bit_generator, uint64_t off, uint64_t rng,
+                        npy_intp cnt, bint use_masked, bint bulk):
+    """random_bounded_uint64_fill with or without the bulk fill"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, bulk)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.uint64)
+    cdef uint64_t *out_data = <uint64_t *>np.PyArray_DATA(out)
+
+    with bit_generator.lock, nogil:
+        random_bounded_uint64_fill(&bitgen, off, rng, cnt, use_masked,
+                                   out_data)
+    return out
+
+
+def bounded_uint64_fill_fast(bit_generator, uint64_t off, uint64_t rng,
+                             npy_intp cnt, bint use_masked, bint bulk):
+    """random_bounded_uint64_fill_fast with or without the bulk fill"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, bulk)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.uint64)
+    cdef uint64_t *out_data = <uint64_t *>np.PyArray_DATA(out)
+
+    with bit_generator.lock, nogil:
+        random_bounded_uint64_fill_fast(&bitgen, off, rng, cnt, use_masked,
+                                        out_data)
+    return out
+
+
+def bounded_uint32_fill_fast(bit_generator, uint32_t off, uint32_t rng,
+                             npy_intp cnt, bint use_masked, bint bulk):
+    """random_bounded_uint32_fill_fast with or without the bulk fill"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, bulk)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.uint32)
+    cdef uint32_t *out_data = <uint32_t *>np.PyArray_DATA(out)
+
+    with bit_generator.lock, nogil:
+        random_bounded_uint32_fill_fast(&bitgen, off, rng, cnt, use_masked,
+                                        out_data)
+    return out
+
+
+def alias_table_arrays(p):
+    """prob and alias of the table random_alias_table_init builds for p"""
+    cdef np.ndarray p_arr = np.ascontiguousarray(p, dtype=np.float64)
+    cdef alias_table table
+
+    if random_alias_table_init(&table, p_arr.shape[0],
+                               <double *>np.PyArray_DATA(p_arr)) != 0:
+        raise MemoryError()
+    try:
+        return (np.array(<double[:table.n]>table.prob),
+                np.array(<npy_intp[:table.n]>table.alias))
+    finally:
+        random_alias_table_free(&table)
+
+
+def alias_fill(bit_generator, p, npy_intp cnt, bint bulk):
+    """cnt indices drawn with replacement through an alias table for p"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, bulk)
+    cdef np.ndarray p_arr = np.ascontiguousarray(p, dtype=np.float64)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.int64)
+    cdef int64_t *out_data = <int64_t *>np.PyArray_DATA(out)
+    cdef alias_table table
+
+    if random_alias_table_init(&table, p_arr.shape[0],
+                               <double *>np.PyArray_DATA(p_arr)) != 0:
+        raise MemoryError()
+    with bit_generator.lock, nogil:
+        random_alias_fill(&bitgen, &table, cnt, out_data)
+    random_alias_table_free(&table)
+    return out
+
+
+def weighted_sample_noreplace(bit_generator, p, npy_intp k, bint bulk):
+    """k distinct indices drawn with probabilities proportional to p"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, bulk)
+    cdef np.ndarray p_arr = np.ascontiguousarray(p, dtype=np.float64)
+    cdef npy_intp n = p_arr.shape[0]
+    cdef const double *p_data = <double *>np.PyArray_DATA(p_arr)
+    cdef np.ndarray out = np.empty(k, dtype=np.int64)
+    cdef int64_t *out_data = <int64_t *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with bit_generator.lock, nogil:
+        ret = random_weighted_sample_noreplace(&bitgen, n, p_data, k,
+                                               out_data)
+    if ret != 0:
+        raise MemoryError()
+    return out
+
+
+def shuffle_blocked(bit_generator, np.ndarray x):
+    """Shuffles the items along the first axis of x in place"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, False)
+    cdef char *data = <char *>np.PyArray_DATA(x)
+    cdef npy_intp n = x.shape[0] if x.ndim > 0 else 0
+    cdef npy_intp itemsize = x.itemsize * (x.size // n if n > 0 else 0)
+    cdef int ret
+
+    if not (x.flags.c_contiguous and x.flags.writeable):
+        raise ValueError('x must be C contiguous and writeable')
+    with bit_generator.lock, nogil:
+        ret = random_shuffle_blocked(&bitgen, data, n, itemsize)
+    if ret != 0:
+        raise MemoryError()
+
+
+def poisson_indexed_fill(bit_generator, lam, index):
+    """Poisson draws for the rates lam[index]"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, False)
+    cdef np.ndarray lam_arr = np.ascontiguousarray(lam, dtype=np.float64)
+    cdef np.ndarray index_arr = np.ascontiguousarray(index, dtype=np.intp)
+    cdef npy_intp nparam = lam_arr.shape[0], cnt = index_arr.shape[0]
+    cdef const double *lam_data = <double *>np.PyArray_DATA(lam_arr)
+    cdef const npy_intp *index_data = <npy_intp *>np.PyArray_DATA(index_arr)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.int64)
+    cdef int64_t *out_data = <int64_t *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with bit_generator.lock, nogil:
+        ret = random_poisson_indexed_fill(&bitgen, nparam, lam_data, cnt,
+                                          index_data, out_data)
+    if ret != 0:
+        raise MemoryError()
+    return out
+
+
+def binomial_indexed_fill(bit_generator, n, p, index):
+    """Binomial draws for the parameters n[index] and p[index]"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, False)
+    cdef np.ndarray n_arr = np.ascontiguousarray(n, dtype=np.int64)
+    cdef np.ndarray p_arr = np.ascontiguousarray(p, dtype=np.float64)
+    cdef np.ndarray index_arr = np.ascontiguousarray(index, dtype=np.intp)
+    cdef npy_intp nparam = p_arr.shape[0], cnt = index_arr.shape[0]
+    cdef const int64_t *n_data = <int64_t *>np.PyArray_DATA(n_arr)
+    cdef const double *p_data = <double *>np.PyArray_DATA(p_arr)
+    cdef const npy_intp *index_data = <npy_intp *>np.PyArray_DATA(index_arr)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.int64)
+    cdef int64_t *out_data = <int64_t *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with bit_generator.lock, nogil:
+        ret = random_binomial_indexed_fill(&bitgen, nparam, p_data, n_data,
+                                           cnt, index_data, out_data)
+    if ret != 0:
+        raise MemoryError()
+    return out
+
+
+def hypergeometric_indexed_fill(bit_generator, good, bad, sample, index):
+    """Hypergeometric draws for the parameters at index"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, False)
+    cdef np.ndarray good_arr = np.ascontiguousarray(good, dtype=np.int64)
+    cdef np.ndarray bad_arr = np.ascontiguousarray(bad, dtype=np.int64)
+    cdef np.ndarray sample_arr = np.ascontiguousarray(sample, dtype=np.int64)
+    cdef np.ndarray index_arr = np.ascontiguousarray(index, dtype=np.intp)
+    cdef npy_intp nparam = good_arr.shape[0], cnt = index_arr.shape[0]
+    cdef const int64_t *good_data = <int64_t *>np.PyArray_DATA(good_arr)
+    cdef const int64_t *bad_data = <int64_t *>np.PyArray_DATA(bad_arr)
+    cdef const int64_t *sample_data = <int64_t *>np.PyArray_DATA(sample_arr)
+    cdef const npy_intp *index_data = <npy_intp *>np.PyArray_DATA(index_arr)
+    cdef np.ndarray out = np.empty(cnt, dtype=np.int64)
+    cdef int64_t *out_data = <int64_t *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with bit_generator.lock, nogil:
+        ret = random_hypergeometric_indexed_fill(&bitgen, nparam, good_data,
+                                                 bad_data, sample_data, cnt,
+                                                 index_data, out_data)
+    if ret != 0:
+        raise MemoryError()
+    return out
+
+
+cdef int _mvnormal_init(mvnormal_t *mvn, mean, cov, double tol) except -1:
+    cdef np.ndarray mean_arr = np.ascontiguousarray(mean, dtype=np.float64)
+    cdef np.ndarray cov_arr = np.ascontiguousarray(cov, dtype=np.float64)
+    cdef int ret
+
+    ret = random_mvnormal_init(mvn, mean_arr.shape[0],
+                               <double *>np.PyArray_DATA(mean_arr),
+                               <double *>np.PyArray_DATA(cov_arr), tol)
+    if ret < 0:
+        raise MemoryError()
+    return ret
+
+
+def mvnormal_factor(mean, cov, double tol):
+    """The factor random_mvnormal_init computes, whether it is triangular
+    and the return value of random_mvnormal_init"""
+    cdef mvnormal_t mvn
+    cdef int ret = _mvnormal_init(&mvn, mean, cov, tol)
+
+    try:
+        factor = np.array(<double[:mvn.dim * mvn.dim]>mvn.factor)
+        return factor.reshape(mvn.dim, mvn.dim), bool(mvn.triangular), ret
+    finally:
+        random_mvnormal_free(&mvn)
+
+
+def mvnormal_fill(bit_generator, mean, cov, npy_intp cnt, double tol):
+    """cnt multivariate normal variates through random_mvnormal_fill"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, False)
+    cdef mvnormal_t mvn
+    cdef np.ndarray out
+    cdef double *out_data
+    cdef int ret
+
+    _mvnormal_init(&mvn, mean, cov, tol)
+    out = np.empty((cnt, mvn.dim), dtype=np.float64)
+    out_data = <double *>np.PyArray_DATA(out)
+    with bit_generator.lock, nogil:
+        ret = random_mvnormal_fill(&bitgen, &mvn, cnt, out_data)
+    random_mvnormal_free(&mvn)
+    if ret != 0:
+        raise MemoryError()
+    return out
+
+
+def mvnormal_stack_fill(bit_generator, mean, cov, npy_intp cnt, double tol):
+    """cnt variates for each of the stacked mean[s] and cov[s], and the
+    return value of random_mvnormal_stack_fill"""
+    cdef bitgen_t bitgen = _with_fill(bit_generator, False)
+    cdef np.ndarray mean_arr = np.ascontiguousarray(mean, dtype=np.float64)
+    cdef np.ndarray cov_arr = np.ascontiguousarray(cov, dtype=np.float64)
+    cdef npy_intp nstack = mean_arr.shape[0], dim = mean_arr.shape[1]
+    cdef const double *mean_data = <double *>np.PyArray_DATA(mean_arr)
+    cdef const double *cov_data = <double *>np.PyArray_DATA(cov_arr)
+    cdef np.ndarray out = np.empty((nstack, cnt, dim), dtype=np.float64)
+    cdef double *out_data = <double *>np.PyArray_DATA(out)
+    cdef int ret
+
+    with bit_generator.lock, nogil:
+        ret = random_mvnormal_stack_fill(&bitgen, nstack, dim, mean_data,
+                                         cov_data, tol, cnt, out_data)
+    if ret < 0:
+        raise MemoryError()
+    return out, ret
+
@@ -8,6 +8,7 @@ cdef extern from "numpy/random/bitgen.h":
         uint32_t (*next_uint32)(void *st) nogil
         double (*next_double)(void *st) nogil
         uint64_t (*next_raw)(void *st) nogil
+        void (*next_uint64_fill)(void *st, size_t cnt, uint64_t *out) nogil
 
     ctypedef bitgen bitgen_t
 
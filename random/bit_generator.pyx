@@ -487,6 +487,7 @@ cdef class BitGenerator():
     def __init__(self, seed=None):
         self.lock = Lock()
         self._bitgen.state = <void *>0
+        self._bitgen.next_uint64_fill = NULL
         if type(self) is BitGenerator:
             raise NotImplementedError('BitGenerator is a base class and cannot be instantized')
 
@@ -2,7 +2,7 @@
 #cython: wraparound=False, nonecheck=False, boundscheck=False, cdivision=True, language_level=3
 from numpy cimport npy_intp
 
-from libc.stdint cimport (uint64_t, int32_t, int64_t)
+from libc.stdint cimport (uint64_t, uint32_t, int32_t, int64_t)
 from numpy.random cimport bitgen_t
 
 cdef extern from "numpy/random/distributions.h":
@@ -28,8 +28,38 @@ cdef extern from "numpy/random/distributions.h":
 
     ctypedef s_binomial_t binomial_t
 
+    struct s_alias_table:
+        npy_intp n
+        double *prob
+        npy_intp *alias
+
+    ctypedef s_alias_table alias_table
+
+    struct s_mvnormal_t:
+        npy_intp dim
+        int triangular
+        double *mean
+        double *factor
+
+    ctypedef s_mvnormal_t mvnormal_t
+
+    struct s_bitgen_seek:
+        void *(*copy_state)(const void *st) nogil
+        void (*free_state)(void *st) nogil
+        void (*skip64)(void *st, uint64_t cnt) nogil
+
+    ctypedef s_bitgen_seek bitgen_seek_t
+
     double random_standard_uniform(bitgen_t *bitgen_state) nogil
     void random_standard_uniform_fill(bitgen_t* bitgen_state, npy_intp cnt, double *out) nogil
+    int random_standard_uniform_fill_block(bitgen_t *bitgen_state,
+                                           const bitgen_seek_t *seek,
+                                           npy_intp start, npy_intp cnt,
+                                           double *out) nogil
+    int random_standard_uniform_fill_blocked(bitgen_t *bitgen_state,
+                                             const bitgen_seek_t *seek,
+                                             npy_intp block_size, npy_intp cnt,
+                                             double *out) nogil
     double random_standard_exponential(bitgen_t *bitgen_state) nogil
     double random_standard_exponential_f(bitgen_t *bitgen_state) nogil
     void random_standard_exponential_fill(bitgen_t *bitgen_state, npy_intp cnt, double *out) nogil
@@ -91,6 +121,20 @@ cdef extern from "numpy/random/distributions.h":
     int64_t random_hypergeometric(bitgen_t *bitgen_state, int64_t good, int64_t bad,
                                     int64_t sample) nogil
 
+    int random_poisson_indexed_fill(bitgen_t *bitgen_state, npy_intp nparam,
+                                    const double *lam, npy_intp cnt,
+                                    const npy_intp *index, int64_t *out) nogil
+    int random_binomial_indexed_fill(bitgen_t *bitgen_state, npy_intp nparam,
+                                     const double *p, const int64_t *n,
+                                     npy_intp cnt, const npy_intp *index,
+                                     int64_t *out) nogil
+    int random_hypergeometric_indexed_fill(bitgen_t *bitgen_state,
+                                           npy_intp nparam, const int64_t *good,
+                                           const int64_t *bad,
+                                           const int64_t *sample, npy_intp cnt,
+                                           const npy_intp *index,
+                                           int64_t *out) nogil
+
     uint64_t random_interval(bitgen_t *bitgen_state, uint64_t max) nogil
 
     # Generate random uint64 numbers in closed interval [off, off + rng].
@@ -98,6 +142,17 @@ cdef extern from "numpy/random/distributions.h":
                                    uint64_t off, uint64_t rng,
                                    uint64_t mask, bint use_masked) nogil
 
+    # Opt-in bounded fills that use both halves of 64-bit draws for ranges
+    # that fit in 32 bits, a different stream than the regular fills.
+    void random_bounded_uint64_fill_fast(bitgen_t *bitgen_state,
+                                         uint64_t off, uint64_t rng,
+                                         npy_intp cnt, bint use_masked,
+                                         uint64_t *out) nogil
+    void random_bounded_uint32_fill_fast(bitgen_t *bitgen_state,
+                                         uint32_t off, uint32_t rng,
+                                         npy_intp cnt, bint use_masked,
+                                         uint32_t *out) nogil
+
     void random_multinomial(bitgen_t *bitgen_state, int64_t n, int64_t *mnix,
                             double *pix, npy_intp d, binomial_t *binomial) nogil
 
@@ -112,3 +167,24 @@ cdef extern from "numpy/random/distributions.h":
                                int64_t nsample,
                                size_t num_variates, int64_t *variates) nogil
 
+    int random_alias_table_init(alias_table *table, npy_intp n,
+                                const double *p) nogil
+    void random_alias_table_free(alias_table *table) nogil
+    void random_alias_fill(bitgen_t *bitgen_state, const alias_table *table,
+                           npy_intp cnt, int64_t *out) nogil
+    int random_weighted_sample_noreplace(bitgen_t *bitgen_state, npy_intp n,
+                                         const double *p, npy_intp k,
+                                         int64_t *out) nogil
+
+    int random_shuffle_blocked(bitgen_t *bitgen_state, char *data,
+                               npy_intp n, npy_intp itemsize) nogil
+
+    int random_mvnormal_init(mvnormal_t *mvn, npy_intp dim, const double *mean,
+                             const double *cov, double tol) nogil
+    void random_mvnormal_free(mvnormal_t *mvn) nogil
+    int random_mvnormal_fill(bitgen_t *bitgen_state, const mvnormal_t *mvn,
+                             npy_intp cnt, double *out) nogil
+    int random_mvnormal_stack_fill(bitgen_t *bitgen_state, npy_intp nstack,
+                                   npy_intp dim, const double *mean,
+                                   const double *cov, double tol, npy_intp cnt,
+                                   double *out) nogil
@@ -64,6 +64,9 @@ def configuration(parent_package='', top_path=None):
         'src/distributions/random_mvhg_count.c',
         'src/distributions/random_mvhg_marginals.c',
         'src/distributions/random_hypergeometric.c',
+        'src/distributions/random_weighted.c',
+        'src/distributions/random_shuffle.c',
+        'src/distributions/random_mvnormal.c',
     ]
     config.add_installed_library('npyrandom',
         sources=npyrandom_sources,
@@ -124,6 +127,19 @@ def configuration(parent_package='', top_path=None):
                              define_macros=defs,
                              )
     config.add_data_files('_bounded_integers.pxd')
+    # Test only, with the generator sources for their bulk routines
+    config.add_extension('_random_tests',
+                         sources=['_random_tests.c',
+                                  'src/pcg64/pcg64.c',
+                                  'src/philox/philox.c',
+                                  'src/sfc64/sfc64.c'],
+                         libraries=EXTRA_LIBRARIES,
+                         extra_compile_args=EXTRA_COMPILE_ARGS,
+                         include_dirs=['.', 'src'],
+                         extra_link_args=EXTRA_LINK_ARGS,
+                         depends=depends + ['_random_tests.pyx'],
+                         define_macros=defs + PCG64_DEFS,
+                         )
     config.add_extension('mtrand',
                          sources=['mtrand.c',
                                   'src/legacy/legacy-distributions.c',
@@ -16,6 +16,66 @@ static NPY_INLINE uint64_t next_uint64(bitgen_t *bitgen_state) {
   return bitgen_state->next_uint64(bitgen_state->state);
 }
 
+/* Bulk next_uint64, for bit generators that provide it */
+static NPY_INLINE void next_uint64_fill(bitgen_t *bitgen_state, npy_intp cnt,
+                                        uint64_t *out) {
+  npy_intp i;
+  if (bitgen_state->next_uint64_fill != NULL) {
+    bitgen_state->next_uint64_fill(bitgen_state->state, (size_t)cnt, out);
+    return;
+  }
+  for (i = 0; i < cnt; i++) {
+    out[i] = next_uint64(bitgen_state);
+  }
+}
+
+/* Number of values drawn per next_uint64_fill call by the fill functions */
+#define RANDOM_FILL_BLOCK 256
+
+/*
+ * A block of next_uint64_fill draws that is handed out value by value
+ * through a bitgen_t of its own, so that the scalar samplers can take
+ * their draws from it. Refills never draw more than `left`, the number of
+ * outputs still to produce, as every output consumes at least one draw;
+ * so no draw is wasted and the stream stays that of the scalar samplers.
+ */
+typedef struct s_fill_buffer {
+  bitgen_t *bitgen_state;
+  npy_intp pos, len, left;
+  uint64_t buf[RANDOM_FILL_BLOCK];
+} fill_buffer;
+
+static NPY_INLINE void fill_buffer_refill(fill_buffer *fb) {
+  fb->len = MIN(fb->left, RANDOM_FILL_BLOCK);
+  next_uint64_fill(fb->bitgen_state, fb->len, fb->buf);
+  fb->pos = 0;
+}
+
+static uint64_t fill_buffer_next_uint64(void *st) {
+  fill_buffer *fb = (fill_buffer *)st;
+  if (fb->pos == fb->len) {
+    fill_buffer_refill(fb);
+  }
+  return fb->buf[fb->pos++];
+}
+
+/* next_double is the top 53 bits of next_uint64, see bitgen.h */
+static double fill_buffer_next_double(void *st) {
+  return (fill_buffer_next_uint64(st) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void fill_buffer_init(fill_buffer *fb, bitgen_t *proxy,
+                             bitgen_t *bitgen_state) {
+  fb->bitgen_state = bitgen_state;
+  fb->pos = fb->len = fb->left = 0;
+  proxy->state = fb;
+  proxy->next_uint64 = &fill_buffer_next_uint64;
+  proxy->next_uint32 = NULL;
+  proxy->next_double = &fill_buffer_next_double;
+  proxy->next_raw = &fill_buffer_next_uint64;
+  proxy->next_uint64_fill = NULL;
+}
+
 static NPY_INLINE float next_float(bitgen_t *bitgen_state) {
   return (next_uint32(bitgen_state) >> 9) * (1.0f / 8388608.0f);
 }
@@ -30,9 +90,22 @@ double random_standard_uniform(bitgen_t *bitgen_state) {
 }
 
 void random_standard_uniform_fill(bitgen_t *bitgen_state, npy_intp cnt, double *out) {
-  npy_intp i;
-  for (i = 0; i < cnt; i++) {
-    out[i] = next_double(bitgen_state);
+  npy_intp i, j, n;
+  uint64_t buf[RANDOM_FILL_BLOCK];
+
+  if (bitgen_state->next_uint64_fill == NULL) {
+    for (i = 0; i < cnt; i++) {
+      out[i] = next_double(bitgen_state);
+    }
+    return;
+  }
+  /* next_double is the top 53 bits of next_uint64, see bitgen.h */
+  for (i = 0; i < cnt; i += n) {
+    n = MIN(cnt - i, RANDOM_FILL_BLOCK);
+    next_uint64_fill(bitgen_state, n, buf);
+    for (j = 0; j < n; j++) {
+      out[i + j] = (buf[j] >> 11) * (1.0 / 9007199254740992.0);
+    }
   }
 }
 
@@ -43,6 +116,61 @@ void random_standard_uniform_fill_f(bitgen_t *bitgen_state, npy_intp cnt, float
   }
 }
 
+/*
+ * Fills out[0:cnt] with values start to start + cnt of the uniform stream
+ * of bitgen_state, without changing bitgen_state. The state is only read,
+ * so calls for disjoint blocks can run concurrently on separate threads.
+ * Every value takes exactly one next_uint64 draw, which is what lets a
+ * block seek straight to its start. Returns 0 on success and -1 if the
+ * state could not be copied.
+ */
+int random_standard_uniform_fill_block(bitgen_t *bitgen_state,
+                                       const bitgen_seek_t *seek,
+                                       npy_intp start, npy_intp cnt,
+                                       double *out) {
+  bitgen_t block = *bitgen_state;
+
+  if (cnt == 0) {
+    return 0;
+  }
+  block.state = seek->copy_state(bitgen_state->state);
+  if (block.state == NULL) {
+    return -1;
+  }
+  seek->skip64(block.state, (uint64_t)start);
+  random_standard_uniform_fill(&block, cnt, out);
+  seek->free_state(block.state);
+  return 0;
+}
+
+/*
+ * random_standard_uniform_fill split into blocks of block_size values,
+ * each drawn by random_standard_uniform_fill_block. The output depends on
+ * the seed only, whatever the block size, and bitgen_state is left where
+ * the serial fill would leave it. Callers that fill the blocks on threads
+ * of their own call random_standard_uniform_fill_block for each block and
+ * then skip bitgen_state past all cnt values.
+ */
+int random_standard_uniform_fill_blocked(bitgen_t *bitgen_state,
+                                         const bitgen_seek_t *seek,
+                                         npy_intp block_size, npy_intp cnt,
+                                         double *out) {
+  npy_intp start;
+
+  if (block_size < 1) {
+    block_size = cnt;
+  }
+  for (start = 0; start < cnt; start += block_size) {
+    if (random_standard_uniform_fill_block(bitgen_state, seek, start,
+                                           MIN(block_size, cnt - start),
+                                           out + start) < 0) {
+      return -1;
+    }
+  }
+  seek->skip64(bitgen_state->state, (uint64_t)cnt);
+  return 0;
+}
+
 static double standard_exponential_unlikely(bitgen_t *bitgen_state,
                                                 uint8_t idx, double x) {
   if (idx == 0) {
@@ -72,11 +200,45 @@ double random_standard_exponential(bitgen_t *bitgen_state) {
   return standard_exponential_unlikely(bitgen_state, idx, x);
 }
 
+/*
+ * The fill variants of the ziggurat samplers run the fast path over whole
+ * blocks of draws. At a rejection the draw is put back and the scalar
+ * sampler takes over for that one output, reading from the same block.
+ */
 void random_standard_exponential_fill(bitgen_t * bitgen_state, npy_intp cnt, double * out)
 {
-  npy_intp i;
-  for (i = 0; i < cnt; i++) {
-    out[i] = random_standard_exponential(bitgen_state);
+  npy_intp i, j, n;
+  fill_buffer fb;
+  bitgen_t proxy;
+
+  if (bitgen_state->next_uint64_fill == NULL) {
+    for (i = 0; i < cnt; i++) {
+      out[i] = random_standard_exponential(bitgen_state);
+    }
+    return;
+  }
+  fill_buffer_init(&fb, &proxy, bitgen_state);
+  for (i = 0; i < cnt;) {
+    fb.left = cnt - i;
+    if (fb.pos == fb.len) {
+      fill_buffer_refill(&fb);
+    }
+    n = MIN(fb.len - fb.pos, cnt - i);
+    for (j = 0; j < n; j++) {
+      uint64_t ri = fb.buf[fb.pos + j] >> 3;
+      uint8_t idx = ri & 0xFF;
+      ri >>= 8;
+      if (ri >= ke_double[idx]) {
+        break;
+      }
+      out[i + j] = ri * we_double[idx];
+    }
+    fb.pos += j;
+    i += j;
+    if (j < n) {
+      fb.left = cnt - i;
+      out[i++] = random_standard_exponential(&proxy);
+    }
   }
 }
 
@@ -170,9 +332,40 @@ double random_standard_normal(bitgen_t *bitgen_state) {
 }
 
 void random_standard_normal_fill(bitgen_t *bitgen_state, npy_intp cnt, double *out) {
-  npy_intp i;
-  for (i = 0; i < cnt; i++) {
-    out[i] = random_standard_normal(bitgen_state);
+  npy_intp i, j, n;
+  fill_buffer fb;
+  bitgen_t proxy;
+
+  if (bitgen_state->next_uint64_fill == NULL) {
+    for (i = 0; i < cnt; i++) {
+      out[i] = random_standard_normal(bitgen_state);
+    }
+    return;
+  }
+  fill_buffer_init(&fb, &proxy, bitgen_state);
+  for (i = 0; i < cnt;) {
+    fb.left = cnt - i;
+    if (fb.pos == fb.len) {
+      fill_buffer_refill(&fb);
+    }
+    n = MIN(fb.len - fb.pos, cnt - i);
+    for (j = 0; j < n; j++) {
+      /* r = e3n52sb8, as in random_standard_normal */
+      uint64_t r = fb.buf[fb.pos + j];
+      int idx = r & 0xff;
+      uint64_t rabs = (r >> 9) & 0x000fffffffffffff;
+      double x = rabs * wi_double[idx];
+      if (rabs >= ki_double[idx]) {
+        break;
+      }
+      out[i + j] = ((r >> 8) & 0x1) ? -x : x;
+    }
+    fb.pos += j;
+    i += j;
+    if (j < n) {
+      fb.left = cnt - i;
+      out[i++] = random_standard_normal(&proxy);
+    }
   }
 }
 
@@ -519,11 +712,12 @@ double random_standard_t(bitgen_t *bitgen_state, double df) {
   return sqrt(df / 2) * num / sqrt(denom);
 }
 
-static RAND_INT_TYPE random_poisson_mult(bitgen_t *bitgen_state, double lam) {
+static RAND_INT_TYPE random_poisson_mult(bitgen_t *bitgen_state,
+                                         const poisson_t *poisson) {
   RAND_INT_TYPE X;
   double prod, U, enlam;
 
-  enlam = exp(-lam);
+  enlam = poisson->enlam;
   X = 0;
   prod = 1.0;
   while (1) {
@@ -544,16 +738,12 @@ static RAND_INT_TYPE random_poisson_mult(bitgen_t *bitgen_state, double lam) {
  */
 #define LS2PI 0.91893853320467267
 #define TWELFTH 0.083333333333333333333333
-static RAND_INT_TYPE random_poisson_ptrs(bitgen_t *bitgen_state, double lam) {
+static RAND_INT_TYPE random_poisson_ptrs(bitgen_t *bitgen_state,
+                                         const poisson_t *poisson) {
   RAND_INT_TYPE k;
-  double U, V, slam, loglam, a, b, invalpha, vr, us;
-
-  slam = sqrt(lam);
-  loglam = log(lam);
-  b = 0.931 + 2.53 * slam;
-  a = -0.059 + 0.02483 * b;
-  invalpha = 1.1239 + 1.1328 / (b - 3.4);
-  vr = 0.9277 - 3.6224 / (b - 2);
+  double U, V, us;
+  const double lam = poisson->lam, loglam = poisson->loglam;
+  const double a = poisson->a, b = poisson->b, vr = poisson->vr;
 
   while (1) {
     U = next_double(bitgen_state) - 0.5;
@@ -568,23 +758,52 @@ static RAND_INT_TYPE random_poisson_ptrs(bitgen_t *bitgen_state, double lam) {
     }
     /* log(V) == log(0.0) ok here */
     /* if U==0.0 so that us==0.0, log is ok since always returns */
-    if ((log(V) + log(invalpha) - log(a / (us * us) + b)) <=
+    if ((log(V) + poisson->loginvalpha - log(a / (us * us) + b)) <=
         (-lam + k * loglam - random_loggam(k + 1))) {
       return k;
     }
   }
 }
 
-RAND_INT_TYPE random_poisson(bitgen_t *bitgen_state, double lam) {
+/*
+ * Computes the constants of the Poisson samplers for `lam`, so that draws
+ * for a rate that repeats across a parameter array pay for them once.
+ */
+void random_poisson_setup(poisson_t *poisson, double lam) {
+  double slam, invalpha;
+
+  poisson->lam = lam;
   if (lam >= 10) {
-    return random_poisson_ptrs(bitgen_state, lam);
-  } else if (lam == 0) {
+    slam = sqrt(lam);
+    poisson->loglam = log(lam);
+    poisson->b = 0.931 + 2.53 * slam;
+    poisson->a = -0.059 + 0.02483 * poisson->b;
+    invalpha = 1.1239 + 1.1328 / (poisson->b - 3.4);
+    poisson->loginvalpha = log(invalpha);
+    poisson->vr = 0.9277 - 3.6224 / (poisson->b - 2);
+  } else {
+    poisson->enlam = exp(-lam);
+  }
+}
+
+RAND_INT_TYPE random_poisson_prepared(bitgen_t *bitgen_state,
+                                      const poisson_t *poisson) {
+  if (poisson->lam >= 10) {
+    return random_poisson_ptrs(bitgen_state, poisson);
+  } else if (poisson->lam == 0) {
     return 0;
   } else {
-    return random_poisson_mult(bitgen_state, lam);
+    return random_poisson_mult(bitgen_state, poisson);
   }
 }
 
+RAND_INT_TYPE random_poisson(bitgen_t *bitgen_state, double lam) {
+  poisson_t poisson;
+
+  random_poisson_setup(&poisson, lam);
+  return random_poisson_prepared(bitgen_state, &poisson);
+}
+
 RAND_INT_TYPE random_negative_binomial(bitgen_t *bitgen_state, double n,
                                        double p) {
   double Y = random_gamma(bitgen_state, n, (1 - p) / p);
@@ -1457,6 +1676,108 @@ npy_bool random_buffered_bounded_bool(bitgen_t *bitgen_state, npy_bool off,
   return buffered_bounded_bool(bitgen_state, off, rng, mask, bcnt, buf);
 }
 
+/*
+ * Bounded 64-bit fill over blocks of next_uint64_fill draws, producing the
+ * same values as bounded_masked_uint64 and bounded_lemire_uint64. Every
+ * value takes one draw plus one per rejection, so a block never holds more
+ * draws than values left to produce, and the output index advances only on
+ * acceptance so that rejected draws are overwritten without a branch.
+ * Lemire's rejection test is leftover < threshold, as threshold < rng + 1.
+ */
+static void bounded_uint64_fill_buffered(bitgen_t *bitgen_state, uint64_t off,
+                                         uint64_t rng, npy_intp cnt,
+                                         bool use_masked, uint64_t *out) {
+  fill_buffer fb;
+  npy_intp i = 0, j;
+
+  fb.bitgen_state = bitgen_state;
+  if (use_masked) {
+    const uint64_t mask = gen_mask(rng);
+
+    while (i < cnt) {
+      fb.left = cnt - i;
+      fill_buffer_refill(&fb);
+      for (j = 0; j < fb.len; j++) {
+        const uint64_t val = fb.buf[j] & mask;
+        out[i] = off + val;
+        i += (val <= rng);
+      }
+    }
+  } else {
+#if __SIZEOF_INT128__
+    const uint64_t rng_excl = rng + 1;
+    const uint64_t threshold = (UINT64_MAX - rng) % rng_excl;
+
+    while (i < cnt) {
+      fb.left = cnt - i;
+      fill_buffer_refill(&fb);
+      for (j = 0; j < fb.len; j++) {
+        const __uint128_t m = ((__uint128_t)fb.buf[j]) * rng_excl;
+        out[i] = off + (uint64_t)(m >> 64);
+        i += ((uint64_t)m >= threshold);
+      }
+    }
+#else
+    for (i = 0; i < cnt; i++) {
+      out[i] = off + bounded_lemire_uint64(bitgen_state, rng);
+    }
+#endif
+  }
+}
+
+/*
+ * One block of bounded 32-bit values, without offset, taken from both
+ * halves of next_uint64_fill draws, low half first. A block holds at most
+ * half of the `left` values still to produce, so a single remaining value
+ * is drawn from the low half of a single draw. Writes fewer than
+ * 2 * RANDOM_FILL_BLOCK + 1 values and returns how many were accepted.
+ * This does not follow the next_uint32 stream.
+ */
+static npy_intp bounded_uint32_halves_block(bitgen_t *bitgen_state,
+                                            uint32_t rng, npy_intp left,
+                                            bool use_masked, uint32_t *out) {
+  uint64_t buf[RANDOM_FILL_BLOCK];
+  const npy_intp n = MAX(MIN(left / 2, RANDOM_FILL_BLOCK), 1);
+  npy_intp i = 0, j;
+
+  next_uint64_fill(bitgen_state, n, buf);
+  /* Any value is accepted when rng is 0xFFFFFFFF, as in the masked method */
+  if (use_masked || rng == 0xFFFFFFFFUL) {
+    const uint32_t mask = (uint32_t)gen_mask(rng);
+
+    if (left == 1) {
+      out[0] = (uint32_t)buf[0] & mask;
+      return (out[0] <= rng);
+    }
+    for (j = 0; j < n; j++) {
+      const uint32_t lo = (uint32_t)buf[j] & mask;
+      const uint32_t hi = (uint32_t)(buf[j] >> 32) & mask;
+      out[i] = lo;
+      i += (lo <= rng);
+      out[i] = hi;
+      i += (hi <= rng);
+    }
+  } else {
+    const uint32_t rng_excl = rng + 1;
+    const uint32_t threshold = (UINT32_MAX - rng) % rng_excl;
+
+    if (left == 1) {
+      const uint64_t lo = (buf[0] & 0xFFFFFFFFUL) * rng_excl;
+      out[0] = (uint32_t)(lo >> 32);
+      return ((uint32_t)lo >= threshold);
+    }
+    for (j = 0; j < n; j++) {
+      const uint64_t lo = (buf[j] & 0xFFFFFFFFUL) * rng_excl;
+      const uint64_t hi = (buf[j] >> 32) * rng_excl;
+      out[i] = (uint32_t)(lo >> 32);
+      i += ((uint32_t)lo >= threshold);
+      out[i] = (uint32_t)(hi >> 32);
+      i += ((uint32_t)hi >= threshold);
+    }
+  }
+  return i;
+}
+
 /*
  * Fills an array with cnt random npy_uint64 between off and off + rng
  * inclusive. The numbers wrap if rng is sufficiently large.
@@ -1503,9 +1824,14 @@ void random_bounded_uint64_fill(bitgen_t *bitgen_state, uint64_t off,
     }
   } else if (rng == 0xFFFFFFFFFFFFFFFFULL) {
     /* Lemire64 doesn't support rng = 0xFFFFFFFFFFFFFFFF. */
-    for (i = 0; i < cnt; i++) {
-      out[i] = off + next_uint64(bitgen_state);
+    next_uint64_fill(bitgen_state, cnt, out);
+    if (off != 0) {
+      for (i = 0; i < cnt; i++) {
+        out[i] += off;
+      }
     }
+  } else if (bitgen_state->next_uint64_fill != NULL) {
+    bounded_uint64_fill_buffered(bitgen_state, off, rng, cnt, use_masked, out);
   } else {
     if (use_masked) {
       /* Smallest bit mask >= max */
@@ -1522,6 +1848,31 @@ void random_bounded_uint64_fill(bitgen_t *bitgen_state, uint64_t off,
   }
 }
 
+/*
+ * As random_bounded_uint64_fill, except that ranges that fit in 32 bits
+ * use both halves of bulk 64-bit draws instead of next_uint32, which
+ * produces a different stream.
+ */
+void random_bounded_uint64_fill_fast(bitgen_t *bitgen_state, uint64_t off,
+                                     uint64_t rng, npy_intp cnt,
+                                     bool use_masked, uint64_t *out) {
+  uint32_t buf[2 * RANDOM_FILL_BLOCK];
+  npy_intp i, j, n;
+
+  if (rng == 0 || rng > 0xFFFFFFFFUL) {
+    random_bounded_uint64_fill(bitgen_state, off, rng, cnt, use_masked, out);
+    return;
+  }
+  /* the same stream as random_bounded_uint32_fill_fast */
+  for (i = 0; i < cnt; i += n) {
+    n = bounded_uint32_halves_block(bitgen_state, (uint32_t)rng, cnt - i,
+                                    use_masked, buf);
+    for (j = 0; j < n; j++) {
+      out[i + j] = off + buf[j];
+    }
+  }
+}
+
 /*
  * Fills an array with cnt random npy_uint32 between off and off + rng
  * inclusive. The numbers wrap if rng is sufficiently large.
@@ -1560,6 +1911,32 @@ void random_bounded_uint32_fill(bitgen_t *bitgen_state, uint32_t off,
   }
 }
 
+/*
+ * As random_bounded_uint32_fill, but using both halves of bulk 64-bit
+ * draws instead of next_uint32, which produces a different stream.
+ */
+void random_bounded_uint32_fill_fast(bitgen_t *bitgen_state, uint32_t off,
+                                     uint32_t rng, npy_intp cnt,
+                                     bool use_masked, uint32_t *out) {
+  npy_intp i;
+
+  if (rng == 0) {
+    for (i = 0; i < cnt; i++) {
+      out[i] = off;
+    }
+    return;
+  }
+  for (i = 0; i < cnt;) {
+    i += bounded_uint32_halves_block(bitgen_state, rng, cnt - i, use_masked,
+                                     out + i);
+  }
+  if (off != 0) {
+    for (i = 0; i < cnt; i++) {
+      out[i] += off;
+    }
+  }
+}
+
 /*
  * Fills an array with cnt random npy_uint16 between off and off + rng
  * inclusive. The numbers wrap if rng is sufficiently large.
@@ -1670,3 +2047,60 @@ void random_multinomial(bitgen_t *bitgen_state, RAND_INT_TYPE n,
       mnix[d - 1] = dn;
   }
 }
+
+/*
+ * Parameter array sampling for repeated parameters. out[i] is drawn with
+ * the parameters at index[i], typically the inverse indices of np.unique
+ * over the broadcast parameters. The setup of every distinct parameter is
+ * computed once, and draws are made in output order, so the values are
+ * those of calling the scalar sampler on each element in turn.
+ *
+ * Return 0 on success and -1 if memory could not be allocated. With no
+ * parameters there is nothing to draw, and nothing is allocated, since
+ * malloc(0) may return NULL.
+ */
+int random_poisson_indexed_fill(bitgen_t *bitgen_state, npy_intp nparam,
+                                const double *lam, npy_intp cnt,
+                                const npy_intp *index, RAND_INT_TYPE *out) {
+  poisson_t *poisson;
+  npy_intp i;
+
+  if (nparam == 0 || cnt == 0) {
+    return 0;
+  }
+  poisson = malloc(nparam * sizeof(poisson_t));
+  if (poisson == NULL) {
+    return -1;
+  }
+  for (i = 0; i < nparam; i++) {
+    random_poisson_setup(&poisson[i], lam[i]);
+  }
+  for (i = 0; i < cnt; i++) {
+    out[i] = random_poisson_prepared(bitgen_state, &poisson[index[i]]);
+  }
+  free(poisson);
+  return 0;
+}
+
+int random_binomial_indexed_fill(bitgen_t *bitgen_state, npy_intp nparam,
+                                 const double *p, const int64_t *n,
+                                 npy_intp cnt, const npy_intp *index,
+                                 int64_t *out) {
+  binomial_t *binomial;
+  npy_intp i;
+
+  if (nparam == 0 || cnt == 0) {
+    return 0;
+  }
+  /* has_binomial is zero until the first draw for each parameter */
+  binomial = calloc(nparam, sizeof(binomial_t));
+  if (binomial == NULL) {
+    return -1;
+  }
+  for (i = 0; i < cnt; i++) {
+    const npy_intp k = index[i];
+    out[i] = random_binomial(bitgen_state, p[k], n[k], &binomial[k]);
+  }
+  free(binomial);
+  return 0;
+}
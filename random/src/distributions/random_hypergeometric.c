@@ -1,6 +1,7 @@
 #include "numpy/random/distributions.h"
 #include "logfactorial.h"
 #include <stdint.h>
+#include <stdlib.h>
 
 /*
  *  Generate a sample from the hypergeometric distribution.
@@ -116,15 +117,16 @@ static int64_t hypergeometric_sample(bitgen_t *bitgen_state,
  *     Mathematics, 31, pp. 181-189 (1990).
  */
 
-static int64_t hypergeometric_hrua(bitgen_t *bitgen_state,
-                                   int64_t good, int64_t bad, int64_t sample)
+static void hypergeometric_hrua_setup(hypergeometric_t *hyper,
+                                      int64_t good, int64_t bad,
+                                      int64_t sample)
 {
     int64_t mingoodbad, maxgoodbad, popsize;
     int64_t computed_sample;
     double p, q;
     double mu, var;
     double a, c, b, h, g;
-    int64_t m, K;
+    int64_t m;
 
     popsize = good + bad;
     computed_sample = MIN(sample, popsize - sample);
@@ -185,6 +187,24 @@ static int64_t hypergeometric_hrua(bitgen_t *bitgen_state,
      */
     b = MIN(MIN(computed_sample, mingoodbad) + 1, floor(a + 16*c));
 
+    hyper->computed_sample = computed_sample;
+    hyper->mingoodbad = mingoodbad;
+    hyper->maxgoodbad = maxgoodbad;
+    hyper->a = a;
+    hyper->b = b;
+    hyper->g = g;
+    hyper->h = h;
+}
+
+static int64_t hypergeometric_hrua(bitgen_t *bitgen_state,
+                                   const hypergeometric_t *hyper)
+{
+    const int64_t computed_sample = hyper->computed_sample;
+    const int64_t mingoodbad = hyper->mingoodbad;
+    const int64_t maxgoodbad = hyper->maxgoodbad;
+    const double a = hyper->a, b = hyper->b, g = hyper->g, h = hyper->h;
+    int64_t K;
+
     while (1) {
         double U, V, X, T;
         double gp;
@@ -222,18 +242,46 @@ static int64_t hypergeometric_hrua(bitgen_t *bitgen_state,
         }
     }
 
-    if (good > bad) {
+    if (hyper->good > hyper->bad) {
         K = computed_sample - K;
     }
 
-    if (computed_sample < sample) {
-        K = good - K;
+    if (computed_sample < hyper->sample) {
+        K = hyper->good - K;
     }
 
     return K;
 }
 
 
+/*
+ *  Compute the setup of random_hypergeometric_prepared for the given
+ *  parameters, under the same assumptions as random_hypergeometric.
+ */
+
+void random_hypergeometric_setup(hypergeometric_t *hyper,
+                                 int64_t good, int64_t bad, int64_t sample)
+{
+    hyper->good = good;
+    hyper->bad = bad;
+    hyper->sample = sample;
+    // The ratio-of-uniforms method is used for all but small samples.
+    hyper->use_hrua = (sample >= 10) && (sample <= good + bad - 10);
+    if (hyper->use_hrua) {
+        hypergeometric_hrua_setup(hyper, good, bad, sample);
+    }
+}
+
+int64_t random_hypergeometric_prepared(bitgen_t *bitgen_state,
+                                       const hypergeometric_t *hyper)
+{
+    if (hyper->use_hrua) {
+        return hypergeometric_hrua(bitgen_state, hyper);
+    }
+    return hypergeometric_sample(bitgen_state, hyper->good, hyper->bad,
+                                 hyper->sample);
+}
+
 /*
  *  Draw a sample from the hypergeometric distribution.
  *
@@ -246,15 +294,42 @@ static int64_t hypergeometric_hrua(bitgen_t *bitgen_state,
 int64_t random_hypergeometric(bitgen_t *bitgen_state,
                               int64_t good, int64_t bad, int64_t sample)
 {
-    int64_t r;
+    hypergeometric_t hyper;
 
-    if ((sample >= 10) && (sample <= good + bad - 10)) {
-        // This will use the ratio-of-uniforms method.
-        r = hypergeometric_hrua(bitgen_state, good, bad, sample);
+    random_hypergeometric_setup(&hyper, good, bad, sample);
+    return random_hypergeometric_prepared(bitgen_state, &hyper);
+}
+
+/*
+ *  Fill out[i] with a sample for the parameters at index[i], computing
+ *  the setup of every distinct parameter set once; see
+ *  random_poisson_indexed_fill.  Returns -1 if memory could not be
+ *  allocated and 0 otherwise.
+ */
+
+int random_hypergeometric_indexed_fill(bitgen_t *bitgen_state,
+                                       npy_intp nparam, const int64_t *good,
+                                       const int64_t *bad,
+                                       const int64_t *sample, npy_intp cnt,
+                                       const npy_intp *index, int64_t *out)
+{
+    hypergeometric_t *hyper;
+    npy_intp i;
+
+    if (nparam == 0 || cnt == 0) {
+        return 0;
     }
-    else {
-        // The simpler implementation is faster for small samples.
-        r = hypergeometric_sample(bitgen_state, good, bad, sample);
+    hyper = malloc(nparam * sizeof(hypergeometric_t));
+    if (hyper == NULL) {
+        return -1;
+    }
+    for (i = 0; i < nparam; i++) {
+        random_hypergeometric_setup(&hyper[i], good[i], bad[i], sample[i]);
+    }
+    for (i = 0; i < cnt; i++) {
+        out[i] = random_hypergeometric_prepared(bitgen_state,
+                                                &hyper[index[i]]);
     }
-    return r;
+    free(hyper);
+    return 0;
 }
@@ -0,0 +1,273 @@
+#include "numpy/random/distributions.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Number of variates transformed per block of standard normals */
+#define MVNORMAL_BLOCK 16
+/* Maximum number of Jacobi sweeps of the eigen fallback */
+#define MVNORMAL_MAX_SWEEPS 64
+
+
+/*
+ * Cholesky factor of cov in the lower triangle of `factor`, with the upper
+ * triangle zeroed.  Returns -1 if a pivot is not positive.
+ */
+static int mvnormal_cholesky(npy_intp dim, const double *cov, double *factor) {
+  npy_intp i, j, k;
+
+  memset(factor, 0, dim * dim * sizeof(double));
+  for (j = 0; j < dim; j++) {
+    const double *Lj = factor + j * dim;
+    double d = cov[j * dim + j];
+
+    for (k = 0; k < j; k++) {
+      d -= Lj[k] * Lj[k];
+    }
+    if (!(d > 0.0)) {
+      return -1;
+    }
+    d = sqrt(d);
+    factor[j * dim + j] = d;
+    for (i = j + 1; i < dim; i++) {
+      double *Li = factor + i * dim;
+      double s = cov[i * dim + j];
+
+      for (k = 0; k < j; k++) {
+        s -= Li[k] * Lj[k];
+      }
+      Li[j] = s / d;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Eigen decomposition of the symmetric cov by cyclic Jacobi rotations,
+ * storing V * sqrt(max(w, 0)) in `factor` so that cov = factor factor^T.
+ * Returns 1 if an eigenvalue is below -tol times the largest magnitude,
+ * -1 if memory could not be allocated and 0 otherwise.
+ */
+static int mvnormal_eigen(npy_intp dim, const double *cov, double tol,
+                          double *factor) {
+  double *A, *V = factor;
+  double off, scale = 0.0, wmax = 0.0;
+  npy_intp i, j, k, p, q;
+  int sweep, ret = 0;
+
+  A = malloc(dim * dim * sizeof(double));
+  if (A == NULL) {
+    return -1;
+  }
+  /* Use the symmetric part, as the factor can only describe that */
+  for (i = 0; i < dim; i++) {
+    for (j = 0; j < dim; j++) {
+      A[i * dim + j] = 0.5 * (cov[i * dim + j] + cov[j * dim + i]);
+      V[i * dim + j] = (i == j) ? 1.0 : 0.0;
+      scale += A[i * dim + j] * A[i * dim + j];
+    }
+  }
+
+  for (sweep = 0; sweep < MVNORMAL_MAX_SWEEPS; sweep++) {
+    off = 0.0;
+    for (p = 0; p < dim; p++) {
+      for (q = p + 1; q < dim; q++) {
+        off += A[p * dim + q] * A[p * dim + q];
+      }
+    }
+    if (off <= 1e-32 * scale) {
+      break;
+    }
+    for (p = 0; p < dim; p++) {
+      for (q = p + 1; q < dim; q++) {
+        const double apq = A[p * dim + q];
+        double theta, t, c, s;
+
+        if (apq == 0.0) {
+          continue;
+        }
+        theta = (A[q * dim + q] - A[p * dim + p]) / (2.0 * apq);
+        t = 1.0 / (fabs(theta) + sqrt(theta * theta + 1.0));
+        if (theta < 0.0) {
+          t = -t;
+        }
+        c = 1.0 / sqrt(t * t + 1.0);
+        s = t * c;
+        /* A = J^T A J, first the columns p and q, then the rows */
+        for (k = 0; k < dim; k++) {
+          const double akp = A[k * dim + p], akq = A[k * dim + q];
+          A[k * dim + p] = c * akp - s * akq;
+          A[k * dim + q] = s * akp + c * akq;
+        }
+        for (k = 0; k < dim; k++) {
+          const double apk = A[p * dim + k], aqk = A[q * dim + k];
+          A[p * dim + k] = c * apk - s * aqk;
+          A[q * dim + k] = s * apk + c * aqk;
+        }
+        for (k = 0; k < dim; k++) {
+          const double vkp = V[k * dim + p], vkq = V[k * dim + q];
+          V[k * dim + p] = c * vkp - s * vkq;
+          V[k * dim + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  for (j = 0; j < dim; j++) {
+    wmax = MAX(wmax, fabs(A[j * dim + j]));
+  }
+  for (j = 0; j < dim; j++) {
+    const double w = A[j * dim + j];
+    const double sw = w > 0.0 ? sqrt(w) : 0.0;
+
+    if (w < -tol * wmax) {
+      ret = 1;
+    }
+    for (i = 0; i < dim; i++) {
+      V[i * dim + j] *= sw;
+    }
+  }
+  free(A);
+  return ret;
+}
+
+/*
+ *  random_mvnormal_init
+ *
+ *  Factorize the dim x dim covariance `cov` once, so that variates can be
+ *  drawn as mean + factor z for standard normal z.  The Cholesky factor is
+ *  used when cov is positive definite; otherwise the factor comes from an
+ *  eigen decomposition with negative eigenvalues clipped to zero.
+ *
+ *  Returns 0 on success, 1 if cov has an eigenvalue below -tol times its
+ *  largest one (the sampler is still usable, as for check_valid='warn'),
+ *  and -1 if memory could not be allocated.  Unless -1 is returned, the
+ *  sampler must be released with `random_mvnormal_free`.
+ */
+
+int random_mvnormal_init(mvnormal_t *mvn, npy_intp dim, const double *mean,
+                         const double *cov, double tol) {
+  int ret = 0;
+
+  mvn->dim = dim;
+  mvn->mean = malloc(dim * sizeof(double));
+  mvn->factor = malloc(dim * dim * sizeof(double));
+  if (mvn->mean == NULL || mvn->factor == NULL) {
+    random_mvnormal_free(mvn);
+    return -1;
+  }
+  memcpy(mvn->mean, mean, dim * sizeof(double));
+
+  mvn->triangular = 1;
+  if (mvnormal_cholesky(dim, cov, mvn->factor) < 0) {
+    mvn->triangular = 0;
+    ret = mvnormal_eigen(dim, cov, tol, mvn->factor);
+    if (ret < 0) {
+      random_mvnormal_free(mvn);
+    }
+  }
+  return ret;
+}
+
+void random_mvnormal_free(mvnormal_t *mvn) {
+  free(mvn->mean);
+  free(mvn->factor);
+  mvn->mean = NULL;
+  mvn->factor = NULL;
+}
+
+/*
+ *  random_mvnormal_fill
+ *
+ *  Fill the cnt x dim array `out` with variates.  Standard normals are
+ *  drawn a block of rows at a time in the order of `out`, and every row of
+ *  the factor is applied to the whole block while it is in cache; a
+ *  triangular factor skips its zero upper part.
+ *
+ *  Returns 0 on success and -1 if memory could not be allocated.
+ */
+
+int random_mvnormal_fill(bitgen_t *bitgen_state, const mvnormal_t *mvn,
+                         npy_intp cnt, double *out) {
+  const npy_intp dim = mvn->dim;
+  double *z;
+  npy_intp r, i, j, m, rows;
+
+  z = malloc(MVNORMAL_BLOCK * dim * sizeof(double));
+  if (z == NULL) {
+    return -1;
+  }
+  for (r = 0; r < cnt; r += rows) {
+    rows = MIN(cnt - r, MVNORMAL_BLOCK);
+    random_standard_normal_fill(bitgen_state, rows * dim, z);
+    for (i = 0; i < dim; i++) {
+      const double *Fi = mvn->factor + i * dim;
+      const npy_intp len = mvn->triangular ? i + 1 : dim;
+
+      /* Four rows at a time for independent accumulation chains */
+      for (m = 0; m + 4 <= rows; m += 4) {
+        const double *z0 = z + m * dim, *z1 = z0 + dim;
+        const double *z2 = z1 + dim, *z3 = z2 + dim;
+        double a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+
+        for (j = 0; j < len; j++) {
+          a0 += Fi[j] * z0[j];
+          a1 += Fi[j] * z1[j];
+          a2 += Fi[j] * z2[j];
+          a3 += Fi[j] * z3[j];
+        }
+        out[(r + m) * dim + i] = mvn->mean[i] + a0;
+        out[(r + m + 1) * dim + i] = mvn->mean[i] + a1;
+        out[(r + m + 2) * dim + i] = mvn->mean[i] + a2;
+        out[(r + m + 3) * dim + i] = mvn->mean[i] + a3;
+      }
+      for (; m < rows; m++) {
+        const double *zm = z + m * dim;
+        double acc = 0.0;
+
+        for (j = 0; j < len; j++) {
+          acc += Fi[j] * zm[j];
+        }
+        out[(r + m) * dim + i] = mvn->mean[i] + acc;
+      }
+    }
+  }
+  free(z);
+  return 0;
+}
+
+/*
+ *  random_mvnormal_stack_fill
+ *
+ *  Batched form for a stack of nstack covariance matrices: draws cnt
+ *  variates for every (mean[s], cov[s]) into out[s], with out of shape
+ *  (nstack, cnt, dim).  Every matrix is factorized once.
+ *
+ *  Returns -1 if memory could not be allocated, otherwise 1 if any of the
+ *  matrices is not positive semidefinite within tol and 0 if none is.
+ */
+
+int random_mvnormal_stack_fill(bitgen_t *bitgen_state, npy_intp nstack,
+                               npy_intp dim, const double *mean,
+                               const double *cov, double tol, npy_intp cnt,
+                               double *out) {
+  mvnormal_t mvn;
+  npy_intp s;
+  int ret = 0, r;
+
+  for (s = 0; s < nstack; s++) {
+    r = random_mvnormal_init(&mvn, dim, mean + s * dim, cov + s * dim * dim,
+                             tol);
+    if (r < 0) {
+      return -1;
+    }
+    ret |= r;
+    r = random_mvnormal_fill(bitgen_state, &mvn, cnt, out + s * cnt * dim);
+    random_mvnormal_free(&mvn);
+    if (r < 0) {
+      return -1;
+    }
+  }
+  return ret;
+}
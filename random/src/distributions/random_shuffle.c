@@ -0,0 +1,146 @@
+#include "numpy/random/distributions.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Bytes of data per bucket, sized to stay in cache while shuffled */
+#define SHUFFLE_BUCKET_BYTES (1 << 20)
+/* Number of buckets scattered to at once, bounded by TLB reach */
+#define SHUFFLE_MAX_BUCKETS 1024
+
+static NPY_INLINE void shuffle_swap(char *a, char *b, npy_intp itemsize) {
+  char tmp[256];
+
+  while (itemsize > 0) {
+    const npy_intp m = MIN(itemsize, (npy_intp)sizeof(tmp));
+    memcpy(tmp, a, m);
+    memcpy(a, b, m);
+    memcpy(b, tmp, m);
+    a += m;
+    b += m;
+    itemsize -= m;
+  }
+}
+
+/* Swaps two items of a fixed size, which compiles to plain loads and stores */
+#define SHUFFLE_SWAP_FIXED(a, b, type)                                         \
+  do {                                                                         \
+    type _ta, _tb;                                                             \
+    memcpy(&_ta, (a), sizeof(type));                                           \
+    memcpy(&_tb, (b), sizeof(type));                                           \
+    memcpy((a), &_tb, sizeof(type));                                           \
+    memcpy((b), &_ta, sizeof(type));                                           \
+  } while (0)
+
+/*
+ * Fisher-Yates shuffle of n items of itemsize bytes, with the draws of
+ * Generator.shuffle, so that inputs that are not split into buckets keep
+ * its stream. The items need not be aligned.
+ */
+static void shuffle_local(bitgen_t *bitgen_state, char *data, npy_intp n,
+                          npy_intp itemsize) {
+  npy_intp i, j;
+
+  if (itemsize == sizeof(int64_t)) {
+    for (i = n - 1; i > 0; i--) {
+      j = (npy_intp)random_interval(bitgen_state, (uint64_t)i);
+      SHUFFLE_SWAP_FIXED(data + i * itemsize, data + j * itemsize, int64_t);
+    }
+  } else if (itemsize == sizeof(int32_t)) {
+    for (i = n - 1; i > 0; i--) {
+      j = (npy_intp)random_interval(bitgen_state, (uint64_t)i);
+      SHUFFLE_SWAP_FIXED(data + i * itemsize, data + j * itemsize, int32_t);
+    }
+  } else {
+    for (i = n - 1; i > 0; i--) {
+      j = (npy_intp)random_interval(bitgen_state, (uint64_t)i);
+      if (i != j) {
+        shuffle_swap(data + i * itemsize, data + j * itemsize, itemsize);
+      }
+    }
+  }
+}
+
+/*
+ *  random_shuffle_blocked
+ *
+ *  Shuffle in place the n contiguous items of itemsize bytes at `data`;
+ *  with itemsize the size of a row this shuffles the rows of a C-contiguous
+ *  array, moving them with memcpy.
+ *
+ *  A Fisher-Yates pass swaps with a random position for every item, which
+ *  misses the cache for nearly every item once the data exceeds it.  Large
+ *  inputs instead use the method of Rao and Sandelius: every item is sent
+ *  to one of nb buckets chosen uniformly and independently, each bucket is
+ *  shuffled in turn, and the buckets are concatenated, which gives a
+ *  uniform permutation.  The scatter writes to at most SHUFFLE_MAX_BUCKETS
+ *  sequential streams, and buckets that are still larger than the cache
+ *  are shuffled the same way.  This needs a temporary copy of the data and
+ *  its random stream differs from that of a plain Fisher-Yates shuffle;
+ *  inputs of less than two buckets are shuffled in place with the stream
+ *  of Generator.shuffle.  The items need not be aligned.
+ *
+ *  Returns 0 on success and -1 if memory could not be allocated.
+ */
+
+int random_shuffle_blocked(bitgen_t *bitgen_state, char *data, npy_intp n,
+                           npy_intp itemsize) {
+  uint16_t *bucket;
+  npy_intp *end;
+  char *tmp;
+  npy_intp nb, i, lo;
+  int ret = 0;
+
+  if (n < 2 || itemsize == 0) {
+    return 0;
+  }
+  nb = MIN(n * itemsize / SHUFFLE_BUCKET_BYTES, SHUFFLE_MAX_BUCKETS);
+  if (nb < 2) {
+    shuffle_local(bitgen_state, data, n, itemsize);
+    return 0;
+  }
+
+  tmp = malloc(n * itemsize);
+  bucket = malloc(n * sizeof(uint16_t));
+  end = calloc(nb + 1, sizeof(npy_intp));
+  if (tmp == NULL || bucket == NULL || end == NULL) {
+    ret = -1;
+    goto finish;
+  }
+
+  random_bounded_uint16_fill(bitgen_state, 0, (uint16_t)(nb - 1), n, false,
+                             bucket);
+  for (i = 0; i < n; i++) {
+    end[bucket[i] + 1]++;
+  }
+  for (i = 0; i < nb; i++) {
+    end[i + 1] += end[i];
+  }
+  /* end[b] starts at the beginning of bucket b and moves to its end */
+  if (itemsize == sizeof(int64_t)) {
+    for (i = 0; i < n; i++) {
+      memcpy(tmp + end[bucket[i]]++ * sizeof(int64_t),
+             data + i * sizeof(int64_t), sizeof(int64_t));
+    }
+  } else {
+    for (i = 0; i < n; i++) {
+      memcpy(tmp + end[bucket[i]]++ * itemsize, data + i * itemsize,
+             itemsize);
+    }
+  }
+  free(bucket);
+  bucket = NULL;
+
+  /* Copy each bucket back and shuffle it while it is in cache */
+  for (i = 0, lo = 0; i < nb && ret == 0; lo = end[i++]) {
+    memcpy(data + lo * itemsize, tmp + lo * itemsize, (end[i] - lo) * itemsize);
+    ret = random_shuffle_blocked(bitgen_state, data + lo * itemsize,
+                                 end[i] - lo, itemsize);
+  }
+
+finish:
+  free(tmp);
+  free(bucket);
+  free(end);
+  return ret;
+}
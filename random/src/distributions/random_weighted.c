@@ -0,0 +1,229 @@
+#include "numpy/random/distributions.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Number of variates handled per block by the fill functions */
+#define WEIGHTED_BLOCK 256
+
+
+/*
+ *  random_alias_table_init
+ *
+ *  Build Walker's alias table for the distribution with weights `p`, using
+ *  Vose's method.  Column i of the table is drawn uniformly; it yields i
+ *  with probability prob[i] and alias[i] otherwise.  Building the table is
+ *  O(n), after which every variate costs O(1) and two draws, so the table
+ *  is meant to be kept and reused across calls.
+ *
+ *  Parameters
+ *  ----------
+ *  alias_table *table
+ *      The table to initialize.  Its arrays are allocated here and must be
+ *      released with `random_alias_table_free`.
+ *  npy_intp n
+ *      The number of weights.
+ *  const double *p
+ *      The weights.  They need not sum to one.
+ *
+ *  Returns 0 on success and -1 if memory could not be allocated.
+ *
+ *  Assumptions on the arguments (not checked in the function):
+ *    *  n >= 1
+ *    *  p[k] >= 0 for k in range(n), and sum(p) > 0 is finite
+ */
+
+int random_alias_table_init(alias_table *table, npy_intp n, const double *p) {
+  double *prob;
+  npy_intp *alias, *work;
+  npy_intp i, nsmall = 0, large = n;
+  double total = 0.0;
+
+  prob = malloc(n * sizeof(double));
+  alias = malloc(n * sizeof(npy_intp));
+  /* Stack of columns below average from the front, above it from the back */
+  work = malloc(n * sizeof(npy_intp));
+  if (prob == NULL || alias == NULL || work == NULL) {
+    free(prob);
+    free(alias);
+    free(work);
+    return -1;
+  }
+
+  for (i = 0; i < n; i++) {
+    total += p[i];
+  }
+  for (i = 0; i < n; i++) {
+    prob[i] = p[i] * n / total;
+    if (prob[i] < 1.0) {
+      work[nsmall++] = i;
+    } else {
+      work[--large] = i;
+    }
+  }
+  while (nsmall > 0 && large < n) {
+    npy_intp s = work[--nsmall];
+    npy_intp l = work[large];
+
+    alias[s] = l;
+    prob[l] = (prob[l] + prob[s]) - 1.0;
+    if (prob[l] < 1.0) {
+      large++;
+      work[nsmall++] = l;
+    }
+  }
+  /* What is left is at average up to rounding */
+  while (nsmall > 0) {
+    i = work[--nsmall];
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+  for (; large < n; large++) {
+    i = work[large];
+    prob[i] = 1.0;
+    alias[i] = i;
+  }
+  free(work);
+
+  table->n = n;
+  table->prob = prob;
+  table->alias = alias;
+  return 0;
+}
+
+void random_alias_table_free(alias_table *table) {
+  free(table->prob);
+  free(table->alias);
+  table->prob = NULL;
+  table->alias = NULL;
+  table->n = 0;
+}
+
+/*
+ *  random_alias_fill
+ *
+ *  Fill `out` with `cnt` indices drawn with replacement from the
+ *  distribution of an alias table.  Columns and coins are drawn a block at
+ *  a time through the bulk bounded integer and uniform fills.
+ */
+
+void random_alias_fill(bitgen_t *bitgen_state, const alias_table *table,
+                       npy_intp cnt, int64_t *out) {
+  double u[WEIGHTED_BLOCK];
+  npy_intp i, j, m;
+
+  for (i = 0; i < cnt; i += m) {
+    m = MIN(cnt - i, WEIGHTED_BLOCK);
+    random_bounded_uint64_fill(bitgen_state, 0, (uint64_t)(table->n - 1), m,
+                               false, (uint64_t *)(out + i));
+    random_standard_uniform_fill(bitgen_state, m, u);
+    for (j = 0; j < m; j++) {
+      const int64_t col = out[i + j];
+      if (u[j] >= table->prob[col]) {
+        out[i + j] = table->alias[col];
+      }
+    }
+  }
+}
+
+
+/* Max-heap of (key, index) pairs on key, used by the sampler below */
+static void weighted_heap_sift_down(double *key, int64_t *idx, npy_intp size,
+                                    npy_intp i) {
+  const double k = key[i];
+  const int64_t v = idx[i];
+
+  for (;;) {
+    npy_intp c = 2 * i + 1;
+    if (c >= size) {
+      break;
+    }
+    if (c + 1 < size && key[c + 1] > key[c]) {
+      c++;
+    }
+    if (key[c] <= k) {
+      break;
+    }
+    key[i] = key[c];
+    idx[i] = idx[c];
+    i = c;
+  }
+  key[i] = k;
+  idx[i] = v;
+}
+
+/*
+ *  random_weighted_sample_noreplace
+ *
+ *  Draw `k` distinct indices from range(n), where index i is picked with
+ *  probability proportional to p[i] among the indices not yet picked.
+ *
+ *  Uses the exponential key method of Efraimidis and Spirakis: index i gets
+ *  the key E_i / p[i] with E_i standard exponential, and the sample is the
+ *  k smallest keys, kept in a max-heap.  This is O(n log k) with one
+ *  draw pass over the weights, instead of O(n k) for renormalizing after
+ *  every pick.  The indices are written in increasing order of key, which
+ *  is the order in which successive weighted picks would produce them.
+ *
+ *  Returns 0 on success and -1 if memory could not be allocated.
+ *
+ *  Assumptions on the arguments (not checked in the function):
+ *    *  p[i] >= 0 for i in range(n)
+ *    *  0 <= k <= the number of nonzero p[i]
+ */
+
+int random_weighted_sample_noreplace(bitgen_t *bitgen_state, npy_intp n,
+                                     const double *p, npy_intp k,
+                                     int64_t *out) {
+  double e[WEIGHTED_BLOCK];
+  double *key;
+  npy_intp i, j, m, size = 0;
+
+  if (k == 0) {
+    return 0;
+  }
+  key = malloc(k * sizeof(double));
+  if (key == NULL) {
+    return -1;
+  }
+
+  for (i = 0; i < n; i += m) {
+    m = MIN(n - i, WEIGHTED_BLOCK);
+    random_standard_exponential_fill(bitgen_state, m, e);
+    for (j = 0; j < m; j++) {
+      double ki;
+      if (!(p[i + j] > 0.0)) {
+        continue;
+      }
+      ki = e[j] / p[i + j];
+      if (size < k) {
+        /* Sift up */
+        npy_intp c = size++;
+        while (c > 0 && key[(c - 1) / 2] < ki) {
+          key[c] = key[(c - 1) / 2];
+          out[c] = out[(c - 1) / 2];
+          c = (c - 1) / 2;
+        }
+        key[c] = ki;
+        out[c] = i + j;
+      } else if (ki < key[0]) {
+        key[0] = ki;
+        out[0] = i + j;
+        weighted_heap_sift_down(key, out, k, 0);
+      }
+    }
+  }
+
+  /* Heap sort into increasing key */
+  for (i = size - 1; i > 0; i--) {
+    const double tk = key[0];
+    const int64_t tv = out[0];
+    key[0] = key[i];
+    out[0] = out[i];
+    key[i] = tk;
+    out[i] = tv;
+    weighted_heap_sift_down(key, out, i, 0);
+  }
+  free(key);
+  return 0;
+}
@@ -1,5 +1,6 @@
 
 #include "pcg64.h"
+#include <stdlib.h>
 
 extern inline void pcg_setseq_128_step_r(pcg_state_setseq_128 *rng);
 extern inline uint64_t pcg_output_xsl_rr_128_64(pcg128_t state);
@@ -69,6 +70,44 @@ pcg128_t pcg_advance_lcg_128(pcg128_t state, pcg128_t delta, pcg128_t cur_mult,
 extern inline uint64_t pcg64_next64(pcg64_state *state);
 extern inline uint32_t pcg64_next32(pcg64_state *state);
 
+/*
+ * Writes the next cnt outputs of pcg64_next64. The LCG is a serial
+ * dependency chain, so four consecutive states are stepped at once by the
+ * multiplier and increment of a stride of 4, which yields the same stream.
+ */
+extern void pcg64_fill64(pcg64_state *state, size_t cnt, uint64_t *out) {
+  pcg64_random_t *rng = state->pcg_state;
+  size_t i = 0;
+#ifndef PCG_EMULATED_128BIT_MATH
+  if (cnt >= 8) {
+    const pcg128_t mult2 = PCG_DEFAULT_MULTIPLIER_128 * PCG_DEFAULT_MULTIPLIER_128;
+    const pcg128_t plus2 = (PCG_DEFAULT_MULTIPLIER_128 + 1) * rng->inc;
+    const pcg128_t mult4 = mult2 * mult2;
+    const pcg128_t plus4 = (mult2 + 1) * plus2;
+    pcg128_t s0, s1, s2, s3;
+
+    s0 = rng->state * PCG_DEFAULT_MULTIPLIER_128 + rng->inc;
+    s1 = s0 * PCG_DEFAULT_MULTIPLIER_128 + rng->inc;
+    s2 = s1 * PCG_DEFAULT_MULTIPLIER_128 + rng->inc;
+    s3 = s2 * PCG_DEFAULT_MULTIPLIER_128 + rng->inc;
+    for (; i + 4 <= cnt; i += 4) {
+      out[i] = pcg_output_xsl_rr_128_64(s0);
+      out[i + 1] = pcg_output_xsl_rr_128_64(s1);
+      out[i + 2] = pcg_output_xsl_rr_128_64(s2);
+      out[i + 3] = pcg_output_xsl_rr_128_64(s3);
+      rng->state = s3;
+      s0 = s0 * mult4 + plus4;
+      s1 = s1 * mult4 + plus4;
+      s2 = s2 * mult4 + plus4;
+      s3 = s3 * mult4 + plus4;
+    }
+  }
+#endif
+  for (; i < cnt; i++) {
+    out[i] = pcg64_random_r(rng);
+  }
+}
+
 extern void pcg64_advance(pcg64_state *state, uint64_t *step) {
   pcg128_t delta;
 #ifndef PCG_EMULATED_128BIT_MATH
@@ -80,6 +119,47 @@ extern void pcg64_advance(pcg64_state *state, uint64_t *step) {
   pcg64_advance_r(state->pcg_state, delta);
 }
 
+/*
+ * Advances the state past the next cnt outputs of pcg64_next64. A fill
+ * split into blocks can seek each copy of the state to the start of its
+ * block and produce the same values as the serial fill.
+ */
+extern void pcg64_skip64(pcg64_state *state, uint64_t cnt) {
+  pcg128_t delta;
+#ifndef PCG_EMULATED_128BIT_MATH
+  delta = cnt;
+#else
+  delta.high = 0;
+  delta.low = cnt;
+#endif
+  pcg64_advance_r(state->pcg_state, delta);
+}
+
+/*
+ * A copy of the state together with the generator it points to, freed
+ * with pcg64_free_state. Returns NULL if memory could not be allocated.
+ */
+typedef struct {
+  pcg64_state state;
+  pcg64_random_t pcg_state;
+} pcg64_state_copy;
+
+extern pcg64_state *pcg64_copy_state(const pcg64_state *state) {
+  pcg64_state_copy *copy = malloc(sizeof(pcg64_state_copy));
+
+  if (copy == NULL) {
+    return NULL;
+  }
+  copy->state = *state;
+  copy->pcg_state = *state->pcg_state;
+  copy->state.pcg_state = &copy->pcg_state;
+  return &copy->state;
+}
+
+extern void pcg64_free_state(pcg64_state *state) {
+  free((pcg64_state_copy *)state);
+}
+
 extern void pcg64_set_seed(pcg64_state *state, uint64_t *seed, uint64_t *inc) {
   pcg128_t s, i;
 #ifndef PCG_EMULATED_128BIT_MATH
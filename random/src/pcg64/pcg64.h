@@ -4,6 +4,7 @@
 #define PCG64_H_INCLUDED 1
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #ifdef _WIN32
 #include <stdlib.h>
@@ -234,8 +235,16 @@ static inline uint32_t pcg64_next32(pcg64_state *state) {
   return (uint32_t)(next & 0xffffffff);
 }
 
+void pcg64_fill64(pcg64_state *state, size_t cnt, uint64_t *out);
+
 void pcg64_advance(pcg64_state *state, uint64_t *step);
 
+void pcg64_skip64(pcg64_state *state, uint64_t cnt);
+
+pcg64_state *pcg64_copy_state(const pcg64_state *state);
+
+void pcg64_free_state(pcg64_state *state);
+
 void pcg64_set_seed(pcg64_state *state, uint64_t *seed, uint64_t *inc);
 
 void pcg64_get_state(pcg64_state *state, uint64_t *state_arr, int *has_uint32,
@@ -1,9 +1,63 @@
 #include "philox.h"
+#include <stdlib.h>
 
 extern NPY_INLINE uint64_t philox_next64(philox_state *state);
 
 extern NPY_INLINE uint32_t philox_next32(philox_state *state);
 
+static NPY_INLINE void philox_increment(philox4x64_ctr_t *ctr) {
+  ctr->v[0]++;
+  /* Handle carry */
+  if (ctr->v[0] == 0) {
+    ctr->v[1]++;
+    if (ctr->v[1] == 0) {
+      ctr->v[2]++;
+      if (ctr->v[2] == 0) {
+        ctr->v[3]++;
+      }
+    }
+  }
+}
+
+/*
+ * Writes the next cnt outputs of philox_next64. Whole blocks go straight
+ * to out, two at a time with their rounds interleaved, since the blocks
+ * of consecutive counters do not depend on each other.
+ */
+extern void philox_fill64(philox_state *state, size_t cnt, uint64_t *out) {
+  size_t i = 0;
+  int j;
+
+  while (i < cnt && state->buffer_pos < PHILOX_BUFFER_SIZE) {
+    out[i++] = state->buffer[state->buffer_pos++];
+  }
+  for (; i + 2 * PHILOX_BUFFER_SIZE <= cnt; i += 2 * PHILOX_BUFFER_SIZE) {
+    philox4x64_key_t key = *state->key;
+    philox4x64_ctr_t ct0, ct1;
+
+    philox_increment(state->ctr);
+    ct0 = *state->ctr;
+    philox_increment(state->ctr);
+    ct1 = *state->ctr;
+    for (j = 0; j < philox4x64_rounds; j++) {
+      if (j > 0) {
+        key = _philox4x64bumpkey(key);
+      }
+      ct0 = _philox4x64round(ct0, key);
+      ct1 = _philox4x64round(ct1, key);
+    }
+    for (j = 0; j < PHILOX_BUFFER_SIZE; j++) {
+      out[i + j] = ct0.v[j];
+      out[i + PHILOX_BUFFER_SIZE + j] = ct1.v[j];
+      /* used up, but kept as philox_next would for the state getter */
+      state->buffer[j] = ct1.v[j];
+    }
+  }
+  for (; i < cnt; i++) {
+    out[i] = philox_next(state);
+  }
+}
+
 extern void philox_jump(philox_state *state) {
   /* Advances state as-if 2^128 draws were made */
   state->ctr->v[2]++;
@@ -27,3 +81,53 @@ extern void philox_advance(uint64_t *step, philox_state *state) {
     }
   }
 }
+
+/*
+ * Advances the state past the next cnt outputs of philox_next64, leaving
+ * the buffer as the serial draws would. Each counter step produces
+ * PHILOX_BUFFER_SIZE outputs, so only the final partial block is computed.
+ */
+extern void philox_skip64(philox_state *state, uint64_t cnt) {
+  uint64_t step[4] = {0, 0, 0, 0};
+  uint64_t avail = PHILOX_BUFFER_SIZE - state->buffer_pos;
+
+  if (cnt <= avail) {
+    state->buffer_pos += (int)cnt;
+    return;
+  }
+  cnt -= avail;
+  /* philox_next steps the counter once more when it refills the buffer */
+  step[0] = (cnt - 1) / PHILOX_BUFFER_SIZE;
+  philox_advance(step, state);
+  state->buffer_pos = PHILOX_BUFFER_SIZE;
+  philox_next(state);
+  state->buffer_pos += (int)((cnt - 1) % PHILOX_BUFFER_SIZE);
+}
+
+/*
+ * A copy of the state together with its counter and key, freed with
+ * philox_free_state. Returns NULL if memory could not be allocated.
+ */
+typedef struct {
+  philox_state state;
+  philox4x64_ctr_t ctr;
+  philox4x64_key_t key;
+} philox_state_copy;
+
+extern philox_state *philox_copy_state(const philox_state *state) {
+  philox_state_copy *copy = malloc(sizeof(philox_state_copy));
+
+  if (copy == NULL) {
+    return NULL;
+  }
+  copy->state = *state;
+  copy->ctr = *state->ctr;
+  copy->key = *state->key;
+  copy->state.ctr = &copy->ctr;
+  copy->state.key = &copy->key;
+  return &copy->state;
+}
+
+extern void philox_free_state(philox_state *state) {
+  free((philox_state_copy *)state);
+}
@@ -241,8 +241,16 @@ static NPY_INLINE uint32_t philox_next32(philox_state *state) {
   return (uint32_t)(next & 0xffffffff);
 }
 
+extern void philox_fill64(philox_state *state, size_t cnt, uint64_t *out);
+
 extern void philox_jump(philox_state *state);
 
 extern void philox_advance(uint64_t *step, philox_state *state);
 
+extern void philox_skip64(philox_state *state, uint64_t cnt);
+
+extern philox_state *philox_copy_state(const philox_state *state);
+
+extern void philox_free_state(philox_state *state);
+
 #endif
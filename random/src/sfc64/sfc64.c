@@ -1,5 +1,24 @@
 #include "sfc64.h"
 
+/*
+ * Writes the next cnt outputs of sfc64_next64, keeping the state in
+ * registers for the whole loop.
+ */
+extern void sfc64_fill64(sfc64_state *state, size_t cnt, uint64_t *out) {
+  uint64_t s[4];
+  size_t i;
+
+  for (i = 0; i < 4; i++) {
+    s[i] = state->s[i];
+  }
+  for (i = 0; i < cnt; i++) {
+    out[i] = sfc64_next(s);
+  }
+  for (i = 0; i < 4; i++) {
+    state->s[i] = s[i];
+  }
+}
+
 extern void sfc64_set_seed(sfc64_state *state, uint64_t *seed) {
   /* Conservatively stick with the original formula. With SeedSequence, it
    * might be fine to just set the state with 4 uint64s and be done.
@@ -0,0 +1,500 @@
+""" Test the npyrandom and bit generator routines that numpy.random does
+not reach directly, through numpy.random._random_tests.
+
+"""
+import pytest
+
+import numpy as np
+from numpy.random import Generator, PCG64, Philox, SFC64
+from numpy.random import _random_tests
+from numpy.testing import assert_allclose, assert_array_equal, assert_equal
+
+BULK_GENERATORS = [PCG64, Philox, SFC64]
+
+
+class TestBulkFill:
+    # lengths around the Philox block of four values and the PCG64 stride
+    # of four, with a few values drawn first to start mid block
+    counts = [0, 1, 2, 3, 4, 5, 7, 8, 9, 255, 256, 257, 1000]
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("skip", [0, 1, 3])
+    def test_fill64_stream(self, bit_generator, skip):
+        bg, ref = bit_generator(1234), bit_generator(1234)
+        bg.random_raw(skip)
+        ref.random_raw(skip)
+        for cnt in self.counts:
+            assert_array_equal(_random_tests.fill64(bg, cnt),
+                               ref.random_raw(cnt))
+        # the state is left where next_uint64 would have left it
+        assert_equal(bg.state, ref.state)
+        assert_array_equal(bg.random_raw(9), ref.random_raw(9))
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    def test_standard_uniform_fill(self, bit_generator):
+        bg, ref = bit_generator(4321), bit_generator(4321)
+        for cnt in self.counts:
+            expected = (ref.random_raw(cnt) >> 11) * 2.0**-53
+            assert_array_equal(
+                _random_tests.standard_uniform_fill(bg, cnt, True), expected)
+        bulk, single = bit_generator(5), bit_generator(5)
+        assert_array_equal(
+            _random_tests.standard_uniform_fill(bulk, 1000, True),
+            _random_tests.standard_uniform_fill(single, 1000, False))
+        assert_equal(bulk.state, single.state)
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("off", [0, 7])
+    def test_bounded_uint64_full_range(self, bit_generator, off):
+        bulk, single = bit_generator(6), bit_generator(6)
+        rng = np.iinfo(np.uint64).max
+        assert_array_equal(
+            _random_tests.bounded_uint64_fill(bulk, off, rng, 1000, True, True),
+            _random_tests.bounded_uint64_fill(single, off, rng, 1000, True,
+                                              False))
+        assert_equal(bulk.state, single.state)
+
+
+class TestZigguratFill:
+    # the bulk fills run the ziggurat fast path over blocks of draws and
+    # hand rejections to the scalar sampler, without changing the stream
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("name", ["standard_normal_fill",
+                                      "standard_exponential_fill"])
+    def test_stream(self, bit_generator, name):
+        fill = getattr(_random_tests, name)
+        bulk, single = bit_generator(7), bit_generator(7)
+        # the longer fills include rejections and tail samples
+        for cnt in [0, 1, 2, 5, 255, 256, 257, 1000, 100000]:
+            assert_array_equal(fill(bulk, cnt, True),
+                               fill(single, cnt, False))
+            # no draw is left unused in the last block
+            assert_equal(bulk.state, single.state)
+
+
+class TestSkip:
+    @pytest.mark.parametrize("bit_generator", [PCG64, Philox])
+    @pytest.mark.parametrize("start", [0, 1, 2, 3, 4, 5])
+    def test_skip64(self, bit_generator, start):
+        # every position in the Philox buffer of four values, skipping to
+        # the same block, to the next ones and far ahead
+        for cnt in list(range(14)) + [1000, 10**6 + 3]:
+            bg, ref = bit_generator(8), bit_generator(8)
+            bg.random_raw(start)
+            ref.random_raw(start)
+            _random_tests.skip64(bg, cnt)
+            ref.random_raw(cnt)
+            assert_equal(bg.state, ref.state)
+            assert_array_equal(bg.random_raw(9), ref.random_raw(9))
+
+    @pytest.mark.parametrize("bit_generator", [PCG64, Philox])
+    @pytest.mark.parametrize("block", [1, 3, 4, 5, 64, 1000])
+    def test_block_partitioned_fill(self, bit_generator, block):
+        # each block seeks its own copy of the state to its start
+        total = 1003
+        blocks = []
+        for start in range(0, total, block):
+            bg = bit_generator(10)
+            _random_tests.skip64(bg, start)
+            blocks.append(_random_tests.fill64(bg, min(block, total - start)))
+        assert_array_equal(np.concatenate(blocks),
+                           bit_generator(10).random_raw(total))
+
+    @pytest.mark.parametrize("bit_generator", [PCG64, Philox])
+    @pytest.mark.parametrize("skip", [0, 1, 3])
+    @pytest.mark.parametrize("block", [0, 1, 3, 4, 5, 64, 1000, 1003, 5000])
+    def test_standard_uniform_fill_blocked(self, bit_generator, skip, block):
+        # the serial stream and state, whatever the block size
+        bg, ref = bit_generator(11), bit_generator(11)
+        bg.random_raw(skip)
+        ref.random_raw(skip)
+        for cnt in [0, 1, 1003]:
+            assert_array_equal(
+                _random_tests.standard_uniform_fill_blocked(bg, cnt, block),
+                Generator(ref).random(cnt))
+            assert_equal(bg.state, ref.state)
+        assert_array_equal(bg.random_raw(9), ref.random_raw(9))
+
+    @pytest.mark.parametrize("bit_generator", [PCG64, Philox])
+    def test_standard_uniform_fill_block_threads(self, bit_generator):
+        # blocks filled concurrently, last first, only read the state
+        from concurrent.futures import ThreadPoolExecutor
+
+        bg = bit_generator(12)
+        bg.random_raw(1)
+        state = bg.state
+        total, block = 100003, 4099
+        out = np.empty(total)
+        starts = list(range(0, total, block))[::-1]
+        with ThreadPoolExecutor(4) as pool:
+            list(pool.map(
+                lambda s: _random_tests.standard_uniform_fill_block(
+                    bg, out[s:s + block], s), starts))
+        assert_equal(bg.state, state)
+        assert_array_equal(out, Generator(bg).random(total))
+
+
+def bounded_halves(bit_generator, rng, cnt, use_masked):
+    """Reference for the opt-in 32-bit stream: both halves of each raw
+    draw, low half first, except that a single value left to produce
+    takes the low half of a draw of its own"""
+    mask = (1 << int(rng).bit_length()) - 1
+    threshold = (1 << 32) % (rng + 1)
+    use_masked = use_masked or rng == 0xFFFFFFFF
+    out = []
+    while len(out) < cnt:
+        left = cnt - len(out)
+        draws = [int(d) for d in
+                 bit_generator.random_raw(max(min(left // 2, 256), 1))]
+        halves = [draws[0] & 0xFFFFFFFF] if left == 1 else \
+                 [h for d in draws for h in (d & 0xFFFFFFFF, d >> 32)]
+        for h in halves:
+            if use_masked:
+                if h & mask <= rng:
+                    out.append(h & mask)
+            else:
+                m = h * (rng + 1)
+                if m & 0xFFFFFFFF >= threshold:
+                    out.append(m >> 32)
+    return out
+
+
+class TestBoundedFill:
+    counts = [0, 1, 2, 3, 255, 256, 257, 513, 2000]
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("rng", [2**32, 2**33 + 5, 2**63, 2**63 + 1,
+                                     2**64 - 2])
+    @pytest.mark.parametrize("use_masked", [True, False])
+    def test_uint64_stream(self, bit_generator, rng, use_masked):
+        # ranges above 32 bits are filled from blocks of bulk draws, with
+        # the values and final state of the per-value loop
+        for fill in [_random_tests.bounded_uint64_fill,
+                     _random_tests.bounded_uint64_fill_fast]:
+            bulk, single = bit_generator(11), bit_generator(11)
+            for cnt in self.counts:
+                res = fill(bulk, 3, rng, cnt, use_masked, True)
+                assert_array_equal(
+                    res, _random_tests.bounded_uint64_fill(
+                        single, 3, rng, cnt, use_masked, False))
+                assert_equal(bulk.state, single.state)
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("rng", [1, 6, 2**20 + 3, 2**31, 2**32 - 2,
+                                     2**32 - 1])
+    @pytest.mark.parametrize("use_masked", [True, False])
+    @pytest.mark.parametrize("bulk", [True, False])
+    def test_fast_halves_stream(self, bit_generator, rng, use_masked, bulk):
+        bg, ref = bit_generator(12), bit_generator(12)
+        for cnt in self.counts:
+            expected = np.array(bounded_halves(ref, rng, cnt, use_masked),
+                                dtype=np.uint64)
+            res32 = _random_tests.bounded_uint32_fill_fast(
+                bg, 5, rng, cnt, use_masked, bulk)
+            assert_equal(res32.dtype, np.uint32)
+            assert_array_equal(res32, (expected + 5).astype(np.uint32))
+            assert_equal(bg.state, ref.state)
+
+            expected = np.array(bounded_halves(ref, rng, cnt, use_masked),
+                                dtype=np.uint64)
+            res64 = _random_tests.bounded_uint64_fill_fast(
+                bg, 2**40, rng, cnt, use_masked, bulk)
+            assert_array_equal(res64, expected + np.uint64(2**40))
+            assert_equal(bg.state, ref.state)
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    def test_fast_empty_range(self, bit_generator):
+        bg, ref = bit_generator(13), bit_generator(13)
+        assert_array_equal(
+            _random_tests.bounded_uint32_fill_fast(bg, 9, 0, 10, False, True),
+            np.full(10, 9))
+        assert_array_equal(
+            _random_tests.bounded_uint64_fill_fast(bg, 9, 0, 10, False, True),
+            np.full(10, 9))
+        assert_equal(bg.state, ref.state)
+
+
+class TestWeighted:
+    p = np.array([0.5, 0., 3., 1., 0.25, 7., 0., 2., 1., 1.])
+
+    @pytest.mark.parametrize("p", [p, [1.], [1., 1e-300, 2.],
+                                   np.arange(1., 1001.)])
+    def test_alias_table_distribution(self, p):
+        # column c is drawn with probability 1/n and keeps c with
+        # probability prob[c], so this is the exact distribution sampled
+        p = np.asarray(p, dtype=float)
+        n = len(p)
+        prob, alias = _random_tests.alias_table_arrays(p)
+        assert np.all((prob >= 0) & (prob <= 1))
+        dist = prob.copy()
+        np.add.at(dist, alias, 1. - prob)
+        assert_allclose(dist / n, p / p.sum(), rtol=1e-12, atol=1e-15)
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("bulk", [True, False])
+    def test_alias_stream(self, bit_generator, bulk):
+        # each block of 256 draws its columns, then its coins
+        prob, alias = _random_tests.alias_table_arrays(self.p)
+        bg, ref = bit_generator(14), bit_generator(14)
+        cnt = 1000
+        res = _random_tests.alias_fill(bg, self.p, cnt, bulk)
+        expected = []
+        for m in [256, 256, 256, 232]:
+            cols = _random_tests.bounded_uint64_fill(
+                ref, 0, len(self.p) - 1, m, False, False).astype(np.intp)
+            u = _random_tests.standard_uniform_fill(ref, m, False)
+            expected.append(np.where(u < prob[cols], cols, alias[cols]))
+        assert_array_equal(res, np.concatenate(expected))
+        assert_equal(bg.state, ref.state)
+
+    def test_alias_frequencies(self):
+        cnt = 200000
+        res = _random_tests.alias_fill(PCG64(15), self.p, cnt, True)
+        freq = np.bincount(res, minlength=len(self.p)) / cnt
+        expected = self.p / self.p.sum()
+        # within five standard deviations, never any zero weight index
+        assert np.all(np.abs(freq - expected) <=
+                      5 * np.sqrt(expected * (1 - expected) / cnt))
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("k", [1, 3, 8])
+    def test_noreplace_stream(self, bit_generator, k):
+        # the k smallest exponential keys E_i / p[i], in increasing order
+        p = np.tile(self.p, 60)
+        bg, ref = bit_generator(16), bit_generator(16)
+        res = _random_tests.weighted_sample_noreplace(bg, p, k, True)
+        e = _random_tests.standard_exponential_fill(ref, len(p), False)
+        nonzero = np.flatnonzero(p)
+        keys = e[nonzero] / p[nonzero]
+        assert_array_equal(res, nonzero[np.argsort(keys)[:k]])
+        assert_equal(bg.state, ref.state)
+
+    def test_noreplace_all(self):
+        # every nonzero weight, once
+        res = _random_tests.weighted_sample_noreplace(PCG64(17), self.p, 8,
+                                                      True)
+        assert_array_equal(np.sort(res), np.flatnonzero(self.p))
+        # nothing to pick draws nothing
+        bg = PCG64(17)
+        state = bg.state
+        res = _random_tests.weighted_sample_noreplace(bg, self.p, 0, True)
+        assert_equal(res.shape, (0,))
+        assert_equal(bg.state, state)
+
+    def test_noreplace_frequencies(self):
+        # the first pick is proportional to p, the second to p without the
+        # first
+        p = np.array([1., 2., 3., 4.])
+        bg = PCG64(18)
+        trials = 20000
+        first = np.zeros(4)
+        second = np.zeros(4)
+        for _ in range(trials):
+            a, b = _random_tests.weighted_sample_noreplace(bg, p, 2, True)
+            first[a] += 1
+            second[b] += 1
+        exp_first = p / p.sum()
+        exp_second = np.array([sum(p[j] / p.sum() * p[i] / (p.sum() - p[j])
+                                   for j in range(4) if j != i)
+                               for i in range(4)])
+        for freq, expected in [(first, exp_first), (second, exp_second)]:
+            assert np.all(np.abs(freq / trials - expected) <=
+                          5 * np.sqrt(expected * (1 - expected) / trials))
+
+
+class TestShuffle:
+    def unaligned(self, a):
+        buf = np.empty(a.nbytes + 1, dtype=np.uint8)
+        res = buf[1:].view(a.dtype).reshape(a.shape)
+        res[...] = a
+        return res
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    @pytest.mark.parametrize("dtype", [np.int64, np.int32, np.int8, 'S3',
+                                       np.complex128])
+    @pytest.mark.parametrize("n", [0, 1, 2, 3, 10, 1000])
+    def test_generator_stream(self, bit_generator, dtype, n):
+        # inputs that fit in one bucket are shuffled as by Generator.shuffle
+        a = np.arange(n).astype(dtype)
+        for x in [a.copy(), self.unaligned(a)]:
+            expected = a.copy()
+            Generator(bit_generator(19)).shuffle(expected)
+            bg = bit_generator(19)
+            _random_tests.shuffle_blocked(bg, x)
+            assert_array_equal(x, expected)
+
+    def test_generator_stream_rows(self):
+        a = np.arange(300).reshape(100, 3)
+        expected = a.copy()
+        Generator(PCG64(20)).shuffle(expected)
+        _random_tests.shuffle_blocked(PCG64(20), a)
+        assert_array_equal(a, expected)
+
+    @pytest.mark.parametrize("offset", [0, 1])
+    def test_buckets(self, offset):
+        # 3 MiB of int64, scattered into buckets and shuffled in each
+        a = np.arange(3 << 17, dtype=np.int64)
+        x = self.unaligned(a) if offset else a.copy()
+        _random_tests.shuffle_blocked(PCG64(21), x)
+        assert_array_equal(np.sort(x), a)
+        assert np.mean(x == a) < 0.01
+        y = self.unaligned(a) if offset else a.copy()
+        _random_tests.shuffle_blocked(PCG64(21), y)
+        assert_array_equal(x, y)
+
+    def test_buckets_uniform(self):
+        # 16 rows of 128 KiB go into two buckets; every row must be able
+        # to end up anywhere, with equal frequency
+        rows, trials = 16, 400
+        x = np.zeros((rows, 1 << 14), dtype=np.int64)
+        x[:, 0] = np.arange(rows)
+        bg = PCG64(22)
+        counts = np.zeros((rows, rows))
+        for _ in range(trials):
+            _random_tests.shuffle_blocked(bg, x)
+            counts[x[:, 0], np.arange(rows)] += 1
+            assert_array_equal(np.sort(x[:, 0]), np.arange(rows))
+        expected = trials / rows
+        assert np.all(np.abs(counts - expected) <=
+                      5 * np.sqrt(expected * (1 - 1 / rows)))
+
+
+class TestIndexedFill:
+    # the setup of each distinct parameter is computed once, but the draws
+    # are those of the element-wise samplers of Generator
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    def test_poisson(self, bit_generator):
+        # rates on both sides of the switch to PTRS at 10, and zero
+        rng = np.random.RandomState(44)
+        lam, index = np.unique(rng.choice([0, 0.5, 3, 9.99, 10, 45, 1e4],
+                                          size=1000), return_inverse=True)
+        res = _random_tests.poisson_indexed_fill(bit_generator(44), lam,
+                                                 index)
+        assert_array_equal(res, Generator(bit_generator(44)).poisson(
+            lam[index]))
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    def test_binomial(self, bit_generator):
+        # parameters that alternate, so a single binomial_t would miss
+        n = np.array([5, 100, 100, 3000, 0])
+        p = np.array([0.3, 0.05, 0.7, 0.5, 0.5])
+        index = np.tile(np.arange(5), 200)
+        res = _random_tests.binomial_indexed_fill(bit_generator(45), n, p,
+                                                  index)
+        assert_array_equal(res, Generator(bit_generator(45)).binomial(
+            n[index], p[index]))
+
+    @pytest.mark.parametrize("bit_generator", BULK_GENERATORS)
+    def test_hypergeometric(self, bit_generator):
+        # small samples and both sides of the HRUA bounds
+        good = np.array([5, 100, 20, 1000, 7, 10**6])
+        bad = np.array([5, 50, 30, 10, 3, 10**6])
+        sample = np.array([3, 10, 41, 500, 10, 10**5])
+        index = np.random.RandomState(46).randint(0, 6, size=1000)
+        res = _random_tests.hypergeometric_indexed_fill(
+            bit_generator(46), good, bad, sample, index)
+        assert_array_equal(res, Generator(bit_generator(46)).hypergeometric(
+            good[index], bad[index], sample[index]))
+
+    @pytest.mark.parametrize("nparam", [0, 3])
+    def test_empty(self, nparam):
+        # nothing is drawn, and no parameters is not an allocation failure
+        bg = PCG64(47)
+        state = bg.state
+        index = np.empty(0, dtype=np.intp)
+        lam = np.ones(nparam)
+        n = np.ones(nparam, dtype=np.int64)
+        assert_equal(_random_tests.poisson_indexed_fill(bg, lam, index).size,
+                     0)
+        assert_equal(
+            _random_tests.binomial_indexed_fill(bg, n, lam / 2, index).size, 0)
+        assert_equal(_random_tests.hypergeometric_indexed_fill(
+            bg, n, n, n, index).size, 0)
+        assert_equal(bg.state, state)
+
+
+def random_cov(rng, dim, rank=None):
+    a = rng.standard_normal((dim, dim if rank is None else rank))
+    return a @ a.T
+
+
+class TestMultivariateNormal:
+    # dimensions around the four rows accumulated at once, and a count of
+    # variates that leaves a partial block of standard normals
+    dims = [1, 3, 4, 5, 17]
+
+    @pytest.mark.parametrize("dim", dims)
+    def test_cholesky(self, dim):
+        rng = np.random.RandomState(dim)
+        cov = random_cov(rng, dim)
+        mean = rng.standard_normal(dim)
+        factor, triangular, ret = _random_tests.mvnormal_factor(mean, cov,
+                                                                1e-8)
+        assert triangular
+        assert_equal(ret, 0)
+        assert_allclose(factor, np.linalg.cholesky(cov), rtol=1e-10,
+                        atol=1e-10)
+
+        # mean + factor z, with z drawn in the order of the output
+        res = _random_tests.mvnormal_fill(PCG64(dim), mean, cov, 37, 1e-8)
+        z = Generator(PCG64(dim)).standard_normal((37, dim))
+        assert_allclose(res, mean + z @ factor.T, rtol=1e-12, atol=1e-12)
+
+    @pytest.mark.parametrize("dim", dims[1:])
+    def test_semidefinite(self, dim):
+        # a variable with no variance stops the Cholesky factorization,
+        # and the eigen decomposition is used
+        rng = np.random.RandomState(dim)
+        cov = random_cov(rng, dim, rank=dim - 1)
+        cov[dim // 2, :] = cov[:, dim // 2] = 0
+        mean = rng.standard_normal(dim)
+        factor, triangular, ret = _random_tests.mvnormal_factor(mean, cov,
+                                                                1e-8)
+        assert not triangular
+        assert_equal(ret, 0)
+        assert_allclose(factor @ factor.T, cov, atol=1e-10 * np.abs(cov).max())
+
+        res = _random_tests.mvnormal_fill(Philox(dim), mean, cov, 37, 1e-8)
+        z = Generator(Philox(dim)).standard_normal((37, dim))
+        assert_allclose(res, mean + z @ factor.T, rtol=1e-12, atol=1e-12)
+
+    def test_not_semidefinite(self):
+        cov = np.array([[1., 2.], [2., 1.]])
+        factor, triangular, ret = _random_tests.mvnormal_factor(
+            np.zeros(2), cov, 1e-8)
+        assert not triangular
+        assert_equal(ret, 1)
+        # the negative eigenvalue is clipped to zero
+        w, v = np.linalg.eigh(cov)
+        clipped = (v * np.maximum(w, 0)) @ v.T
+        assert_allclose(factor @ factor.T, clipped, atol=1e-12)
+
+    def test_moments(self):
+        rng = np.random.RandomState(48)
+        cov = random_cov(rng, 6)
+        mean = 10 * rng.standard_normal(6)
+        cnt = 200000
+        res = _random_tests.mvnormal_fill(SFC64(48), mean, cov, cnt, 1e-8)
+        sd = np.sqrt(np.diag(cov))
+        assert np.all(np.abs(res.mean(axis=0) - mean) < 5 * sd / np.sqrt(cnt))
+        # sample covariances are off by about sd_i sd_j / sqrt(cnt)
+        assert np.all(np.abs(np.cov(res.T) - cov) <
+                      6 * np.outer(sd, sd) * np.sqrt(2 / cnt))
+
+    def test_stack(self):
+        rng = np.random.RandomState(49)
+        cov = np.stack([random_cov(rng, 5), random_cov(rng, 5, rank=3),
+                        np.diag([1., 2., -3., 4., 5.])])
+        mean = rng.standard_normal((3, 5))
+        res, ret = _random_tests.mvnormal_stack_fill(PCG64(49), mean, cov,
+                                                     21, 1e-8)
+        assert_equal(ret, 1)
+        # one matrix after the other, from the same stream
+        bg = PCG64(49)
+        for s in range(3):
+            assert_array_equal(res[s], _random_tests.mvnormal_fill(
+                bg, mean[s], cov[s], 21, 1e-8))
+        res, ret = _random_tests.mvnormal_stack_fill(PCG64(49), mean[:2],
+                                                     cov[:2], 21, 1e-8)
+        assert_equal(ret, 0)
@@ -186,6 +186,10 @@ OPTIONAL_FUNCTION_ATTRIBUTES_WITH_INTRINSICS = [('__attribute__((target("avx2,fm
                                 '__m256 temp = _mm256_set1_ps(1.0); temp = \
                                 _mm256_fmadd_ps(temp, temp, temp)',
                                 'immintrin.h'),
+                                ('__attribute__((target("avx,f16c")))',
+                                'attribute_target_f16c_with_intrinsics',
+                                '__m128i temp = _mm256_cvtps_ph(_mm256_set1_ps(1.0), 0)',
+                                'immintrin.h'),
                                 ('__attribute__((target("avx512f")))',
                                 'attribute_target_avx512f_with_intrinsics',
                                 '__m512i temp = _mm512_castps_si512(_mm512_set1_ps(1.0))',
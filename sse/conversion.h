@@ -29,4 +29,34 @@
 #define npyv_cvt_b32_f32(A) _mm_castps_si128(A)
 #define npyv_cvt_b64_f64(A) _mm_castpd_si128(A)
 
+// convert double precision to single precision and vice versa
+NPY_FINLINE npyv_f32 npyv_pack_f32_f64(npyv_f64 a, npyv_f64 b)
+{ return _mm_movelh_ps(_mm_cvtpd_ps(a), _mm_cvtpd_ps(b)); }
+
+NPY_FINLINE npyv_f64x2 npyv_expand_f64_f32(npyv_f32 a)
+{
+    npyv_f64x2 r;
+    r.val[0] = _mm_cvtps_pd(a);
+    r.val[1] = _mm_cvtps_pd(_mm_movehl_ps(a, a));
+    return r;
+}
+
+// expand unsigned 16-bit lanes to 32-bit and narrow them back (truncating)
+NPY_FINLINE npyv_u32x2 npyv_expand_u32_u16(npyv_u16 a)
+{
+    const __m128i z = _mm_setzero_si128();
+    npyv_u32x2 r;
+    r.val[0] = _mm_unpacklo_epi16(a, z);
+    r.val[1] = _mm_unpackhi_epi16(a, z);
+    return r;
+}
+
+NPY_FINLINE npyv_u16 npyv_pack_u16_u32(npyv_u32 a, npyv_u32 b)
+{
+    // sign-extend the low halves so the signed saturation becomes a no-op
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
 #endif // _NPY_SIMD_SSE_CVT_H
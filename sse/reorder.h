@@ -81,4 +81,40 @@ NPYV_IMPL_SSE_ZIP(npyv_s64, s64, epi64)
 NPYV_IMPL_SSE_ZIP(npyv_f32, f32, ps)
 NPYV_IMPL_SSE_ZIP(npyv_f64, f64, pd)
 
+// reverse the byte order of each lane
+#ifdef NPY_HAVE_SSSE3
+    NPY_FINLINE npyv_u16 npyv_bswap_u16(npyv_u16 a)
+    {
+        const __m128i idx = _mm_setr_epi8(1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14);
+        return _mm_shuffle_epi8(a, idx);
+    }
+    NPY_FINLINE npyv_u32 npyv_bswap_u32(npyv_u32 a)
+    {
+        const __m128i idx = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+        return _mm_shuffle_epi8(a, idx);
+    }
+    NPY_FINLINE npyv_u64 npyv_bswap_u64(npyv_u64 a)
+    {
+        const __m128i idx = _mm_setr_epi8(7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8);
+        return _mm_shuffle_epi8(a, idx);
+    }
+#else
+    NPY_FINLINE npyv_u16 npyv_bswap_u16(npyv_u16 a)
+    { return _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8)); }
+    NPY_FINLINE npyv_u32 npyv_bswap_u32(npyv_u32 a)
+    {
+        // swap the 16-bit halves, then the bytes within each half
+        a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        return npyv_bswap_u16(a);
+    }
+    NPY_FINLINE npyv_u64 npyv_bswap_u64(npyv_u64 a)
+    {
+        a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        return npyv_bswap_u16(a);
+    }
+#endif
+#define npyv_bswap_s16 npyv_bswap_u16
+#define npyv_bswap_s32 npyv_bswap_u32
+#define npyv_bswap_s64 npyv_bswap_u64
+
 #endif // _NPY_SIMD_SSE_REORDER_H
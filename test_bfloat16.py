@@ -0,0 +1,99 @@
+""" Test the bfloat16 user dtype.
+
+"""
+import pytest
+
+import numpy as np
+from numpy.core._bfloat16 import bfloat16
+from numpy.testing import assert_equal, assert_array_equal
+
+
+def round_to_bfloat16(a):
+    """Reference round-to-nearest-even of float32 values, as uint16 bits"""
+    bits = np.asarray(a, dtype=np.float32).view(np.uint32).astype(np.uint64)
+    rounded = (bits + 0x7fff + ((bits >> 16) & 1)) >> 16
+    return rounded.astype(np.uint16)
+
+
+class TestBFloat16:
+    def test_scalar(self):
+        assert_equal(float(bfloat16(1.5)), 1.5)
+        assert_equal(float(bfloat16(1 + 2**-9)), 1.0)
+        assert_equal(float(bfloat16("2.0")), 2.0)
+        assert bfloat16(1.0) == 1.0
+        assert bfloat16(1.0) != 1 + 2**-9
+        assert np.isnan(float(bfloat16(np.nan)))
+        assert np.dtype(bfloat16).itemsize == 2
+
+    @pytest.mark.parametrize("size", [1, 7, 8, 15, 16, 17, 31, 32, 33, 1000])
+    def test_float_roundtrip(self, size):
+        rng = np.random.RandomState(size)
+        f = (rng.standard_normal(size) * 1e3).astype(np.float32)
+        b = f.astype(bfloat16)
+        assert_array_equal(b.view(np.uint16), round_to_bfloat16(f))
+        back = b.astype(np.float32)
+        assert_array_equal(back.view(np.uint32),
+                           b.view(np.uint16).astype(np.uint32) << 16)
+
+    def test_special_values(self):
+        f = np.array([0., -0., np.inf, -np.inf, np.nan, 3.4e38],
+                     dtype=np.float32)
+        b = f.astype(bfloat16).astype(np.float32)
+        assert_array_equal(b[:4], f[:4])
+        assert np.isnan(b[4])
+        # the largest float32 rounds up to infinity
+        assert_equal(b[5], np.inf)
+
+    def test_subnormals(self):
+        # contiguous casts are vectorized, strided ones are not; both must
+        # round subnormal inputs instead of flushing them to zero
+        rng = np.random.RandomState(29)
+        bits = rng.randint(0, 1 << 23, size=2000).astype(np.uint32)
+        bits[::2] |= np.uint32(1 << 31)
+        f = np.repeat(bits.view(np.float32), 2)
+        contiguous = f[::2].copy().astype(bfloat16)
+        strided = f[::2].astype(bfloat16)
+        assert_array_equal(contiguous.view(np.uint16),
+                           round_to_bfloat16(f[::2]))
+        assert_array_equal(strided.view(np.uint16),
+                           contiguous.view(np.uint16))
+
+    def test_double_rounding(self):
+        # 1 + 2**-8 is halfway between two bfloat16 values, the tie must be
+        # broken by the bits that float32 would discard
+        d = np.array([1 + 2**-8 + 2**-40, 1 + 2**-8 - 2**-40])
+        assert_array_equal(d.astype(bfloat16).astype(np.float64),
+                           [1 + 2**-7, 1.0])
+
+    def test_int_casts(self):
+        a = np.arange(-128, 128, dtype=np.int8)
+        assert_array_equal(a.astype(bfloat16).astype(np.int8), a)
+        assert np.can_cast(np.int8, bfloat16)
+        assert np.can_cast(bfloat16, np.float32)
+        assert not np.can_cast(np.float32, bfloat16)
+
+    @pytest.mark.parametrize("ufunc", [np.add, np.subtract, np.multiply,
+                                       np.true_divide])
+    @pytest.mark.parametrize("size", [1, 15, 16, 17, 33, 1000])
+    @pytest.mark.parametrize("stride", [-2, 1, 3])
+    def test_arithmetic(self, ufunc, size, stride):
+        rng = np.random.RandomState(size)
+        a = rng.uniform(1, 10, size * abs(stride)).astype(bfloat16)
+        b = rng.uniform(1, 10, size * abs(stride)).astype(bfloat16)
+        expected = ufunc(a[::stride].astype(np.float32),
+                         b[::stride].astype(np.float32))
+        res = ufunc(a[::stride], b[::stride])
+        assert_array_equal(res.view(np.uint16), round_to_bfloat16(expected))
+
+    def test_sum_accumulates_in_float32(self):
+        # every partial sum past 256 is not representable in bfloat16
+        a = np.ones(1000, dtype=bfloat16)
+        assert_equal(float(np.add.reduce(a)), 1000.)
+
+    def test_comparisons(self):
+        a = np.array([1, 2, np.nan], dtype=np.float32).astype(bfloat16)
+        b = np.array([2, 2, 2], dtype=np.float32).astype(bfloat16)
+        assert_array_equal(a < b, [True, False, False])
+        assert_array_equal(a == b, [False, True, False])
+        assert_array_equal(np.isnan(a), [False, False, True])
+        assert_equal(np.argmax(a), 2)
@@ -0,0 +1,172 @@
+""" Test contiguous casts and byte swaps against scalar references.
+
+"""
+import pytest
+
+import numpy as np
+from numpy.testing import assert_array_equal, assert_equal
+
+
+def unaligned(a):
+    buf = np.zeros(a.nbytes + 1, dtype=np.uint8)
+    res = buf[1:].view(a.dtype).reshape(a.shape)
+    res[...] = a
+    return res
+
+
+class TestFloatDoubleCast:
+    # aligned contiguous casts go through vector loops of one float32
+    # vector at a time, with the scalar loop finishing off the rest
+    sizes = [0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64,
+             65, 1000]
+
+    def doubles(self, n):
+        rng = np.random.RandomState(n)
+        special = [np.inf, -np.inf, np.nan, 0., -0., 1e300, -1e300,
+                   3.5e38, -3.5e38, np.finfo(np.float32).max,
+                   1e-40, -1e-40, 1e-45, 1e-50, np.finfo(np.float32).tiny,
+                   1 + 2.**-24, 1 + 3 * 2.**-24]
+        a = rng.standard_normal(n) * 10.**rng.randint(-40, 40, size=n)
+        a[::3] = np.resize(special, a[::3].size)
+        return a
+
+    def floats(self, n):
+        d = self.doubles(n)
+        with np.errstate(over='ignore'):
+            return np.array([np.float32(v) for v in d.tolist()],
+                            dtype=np.float32)
+
+    def check(self, res, expected):
+        assert_equal(res.dtype, expected.dtype)
+        assert_array_equal(res, expected)
+        # the sign of zeros and infinities is kept
+        assert_array_equal(np.signbit(res), np.signbit(expected))
+
+    @pytest.mark.parametrize("n", sizes)
+    def test_double_to_float(self, n):
+        a = self.doubles(n + 3)
+        for offset in range(4):
+            src = a[offset:offset + n]
+            with np.errstate(over='ignore'):
+                expected = np.array([np.float32(v) for v in src.tolist()],
+                                    dtype=np.float32)
+                self.check(src.astype(np.float32), expected)
+                self.check(unaligned(src).astype(np.float32), expected)
+                dst = np.empty(n + 1, dtype=np.float32)[1:]
+                dst[...] = src
+                self.check(dst, expected)
+
+    @pytest.mark.parametrize("n", sizes)
+    def test_float_to_double(self, n):
+        a = self.floats(n + 3)
+        for offset in range(4):
+            src = a[offset:offset + n]
+            expected = np.array([float(v) for v in src.tolist()],
+                                dtype=np.float64)
+            self.check(src.astype(np.float64), expected)
+            self.check(unaligned(src).astype(np.float64), expected)
+            dst = np.empty(n + 1, dtype=np.float64)[1:]
+            dst[...] = src
+            self.check(dst, expected)
+
+    def test_roundtrip(self):
+        a = self.floats(1000)
+        self.check(a.astype(np.float64).astype(np.float32), a)
+
+    def test_overflow_and_subnormals(self):
+        with np.errstate(over='ignore'):
+            res = np.array([1e300, -1e300, 3.5e38, 3.4e38]).astype(np.float32)
+        assert_array_equal(res, [np.inf, -np.inf, np.inf,
+                                 np.float32(3.4e38)])
+        # subnormal float32 results, rounded to nearest even, and underflow
+        tiny = 2.**-149
+        res = np.array([tiny, 1.5 * tiny, 2.5 * tiny, 0.5 * tiny,
+                        0.75 * tiny, -0.25 * tiny] * 3).astype(np.float32)
+        assert_array_equal(res.astype(np.float64),
+                           [tiny, 2 * tiny, 2 * tiny, 0., tiny, -0.] * 3)
+        assert_array_equal(np.signbit(res), [0, 0, 0, 0, 0, 1] * 3)
+        # float32 subnormals are exact in float64
+        sub = np.arange(1, 40, dtype=np.uint32).view(np.float32)
+        assert_array_equal(sub.astype(np.float64),
+                           np.arange(1, 40) * 2.**-149)
+
+
+def as_bytes(a):
+    return np.ascontiguousarray(a).view(np.uint8)
+
+
+def swapped_bytes(a, pair=False):
+    """Reference byte swap of every item, or of both halves of each item"""
+    itemsize = a.dtype.itemsize
+    b = as_bytes(a)
+    if pair:
+        b = b.reshape(-1, 2, itemsize // 2)[:, :, ::-1]
+    else:
+        b = b.reshape(-1, itemsize)[:, ::-1]
+    b = np.ascontiguousarray(b).reshape(-1, itemsize)
+    return b.view(a.dtype.newbyteorder()).ravel()
+
+
+class TestByteSwap:
+    # contiguous items of 2, 4 and 8 bytes, and complex pairs of them, are
+    # swapped a vector at a time, with the scalar loop finishing off the rest
+    dtypes = [np.int16, np.uint16, np.float16, np.int32, np.float32,
+              np.int64, np.float64]
+    pair_dtypes = [np.complex64, np.complex128]
+    sizes = [0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64,
+             65, 100]
+
+    def values(self, dtype, n):
+        rng = np.random.RandomState(n)
+        raw = rng.randint(0, 256, size=n * np.dtype(dtype).itemsize)
+        return raw.astype(np.uint8).view(dtype)
+
+    def check(self, res, a, pair):
+        expected = swapped_bytes(a, pair)
+        assert_array_equal(as_bytes(res), as_bytes(expected))
+
+    @pytest.mark.parametrize("dtype", dtypes + pair_dtypes)
+    @pytest.mark.parametrize("n", sizes)
+    def test_byteswap(self, dtype, n):
+        pair = dtype in self.pair_dtypes
+        a = self.values(dtype, n + 3)
+        for offset in range(4):
+            src = a[offset:offset + n]
+            self.check(src.byteswap(), src, pair)
+            self.check(unaligned(src).byteswap(), src, pair)
+
+            b = src.copy()
+            b.byteswap(inplace=True)
+            self.check(b, src, pair)
+            b = unaligned(src)
+            b.byteswap(inplace=True)
+            self.check(b, src, pair)
+
+            # strided data keeps the scalar loops
+            b = np.repeat(src, 2)
+            b[::2].byteswap(inplace=True)
+            self.check(b[::2], src, pair)
+            assert_array_equal(as_bytes(b[1::2]), as_bytes(src))
+
+    @pytest.mark.parametrize("dtype", dtypes + pair_dtypes)
+    @pytest.mark.parametrize("n", sizes)
+    def test_cast_byte_order(self, dtype, n):
+        # casts between byte orders swap each item, or each half of it
+        pair = dtype in self.pair_dtypes
+        a = self.values(dtype, n + 3)
+        swapped = np.dtype(dtype).newbyteorder()
+        for offset in range(4):
+            src = a[offset:offset + n]
+            expected = as_bytes(swapped_bytes(src, pair))
+            for s in [src, unaligned(src)]:
+                res = s.astype(swapped)
+                assert_equal(res.dtype, swapped)
+                assert_array_equal(as_bytes(res), expected)
+                # and back to the native order
+                assert_array_equal(as_bytes(res.astype(dtype)), as_bytes(src))
+                assert_array_equal(as_bytes(unaligned(res).astype(dtype)),
+                                   as_bytes(src))
+
+                dst = np.empty(n + 1, dtype=swapped)[1:]
+                dst[...] = s
+                assert_array_equal(as_bytes(dst), expected)
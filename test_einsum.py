@@ -0,0 +1,128 @@
+""" Test the einsum fast paths against the general loops.
+
+"""
+import pytest
+
+import numpy as np
+from numpy.testing import assert_allclose, assert_array_equal, assert_raises
+
+
+def unlowered(subscripts, *operands):
+    """einsum through the sum of products loops, which object arrays use"""
+    return np.einsum(subscripts, *[op.astype(object) for op in operands])
+
+
+class TestEinsumMatmul:
+    # large enough to be handed to matmul
+    m, k, n = 40, 33, 37
+
+    @pytest.mark.parametrize("dtype", [np.int64, np.int32, np.float64])
+    def test_matrix_product(self, dtype):
+        rng = np.random.RandomState(33)
+        a = rng.randint(-9, 9, size=(self.m, self.k)).astype(dtype)
+        b = rng.randint(-9, 9, size=(self.k, self.n)).astype(dtype)
+        for subscripts, ops in [("ij,jk->ik", (a, b)),
+                                ("ij,jk->ki", (a, b)),
+                                ("ji,jk->ik", (a.T, b)),
+                                ("ij,kj->ik", (a, b.T)),
+                                ("ji,kj->ki", (a.T, b.T)),
+                                ("ij,jk", (a[::-1], b[:, ::2]))]:
+            res = np.einsum(subscripts, *ops)
+            assert res.dtype == dtype
+            assert_array_equal(res, unlowered(subscripts, *ops))
+
+    def test_batched(self):
+        rng = np.random.RandomState(34)
+        a = rng.randint(-9, 9, size=(3, self.m, self.k))
+        b = rng.randint(-9, 9, size=(3, self.n, self.k))
+        for subscripts in ["bij,bkj->bik", "bij,bkj->bki", "bij,bkj->ibk"]:
+            assert_array_equal(np.einsum(subscripts, a, b),
+                               unlowered(subscripts, a, b))
+
+    def test_broadcast_operands(self):
+        rng = np.random.RandomState(35)
+        row = rng.randint(-9, 9, size=self.k)
+        a = np.broadcast_to(row, (self.m, self.k))
+        b = rng.randint(-9, 9, size=(self.k, self.n))
+        assert_array_equal(np.einsum("ij,jk->ik", a, b),
+                           unlowered("ij,jk->ik", a, b))
+        c = np.broadcast_to(b, (2, self.k, self.n))
+        assert_array_equal(np.einsum("ij,bjk->bik", a, c),
+                           unlowered("ij,bjk->bik", a, c))
+
+    def test_repeated_labels(self):
+        # the diagonal is taken before the product
+        rng = np.random.RandomState(36)
+        a = rng.randint(-9, 9, size=(self.m, self.m, self.k))
+        b = rng.randint(-9, 9, size=(self.k, self.n))
+        assert_array_equal(np.einsum("iij,jk->ik", a, b),
+                           unlowered("iij,jk->ik", a, b))
+
+    def test_out(self):
+        rng = np.random.RandomState(37)
+        a = rng.randint(-9, 9, size=(self.m, self.k))
+        b = rng.randint(-9, 9, size=(self.k, self.n))
+        expected = unlowered("ij,jk->ik", a, b)
+
+        out = np.empty((self.m, self.n), dtype=a.dtype)
+        res = np.einsum("ij,jk->ik", a, b, out=out)
+        assert res is out
+        assert_array_equal(out, expected)
+
+        out = np.empty((self.n, self.m), dtype=a.dtype).T
+        np.einsum("ij,jk->ik", a, b, out=out)
+        assert_array_equal(out, expected)
+
+        # no broadcasting into a larger out, as on the regular path
+        for shape in [(2, self.m, self.n), (1, self.n), (self.m, 1)]:
+            out = np.zeros(shape, dtype=a.dtype)
+            assert_raises(ValueError, np.einsum, "ij,jk->ik", a, b, out=out)
+            assert_raises(ValueError, np.einsum, "ij,jk->ik",
+                          a.astype(object), b.astype(object),
+                          out=out.astype(object))
+
+    def test_out_casting(self):
+        rng = np.random.RandomState(38)
+        a = rng.randint(-9, 9, size=(self.m, self.k)).astype(np.float64)
+        b = rng.randint(-9, 9, size=(self.k, self.n)).astype(np.float64)
+        swapped = np.empty((self.m, self.n), dtype=a.dtype.newbyteorder())
+        assert_raises(TypeError, np.einsum, "ij,jk->ik", a, b,
+                      out=swapped, casting="no")
+        np.einsum("ij,jk->ik", a, b, out=swapped, casting="equiv")
+        assert_array_equal(swapped, unlowered("ij,jk->ik", a, b))
+
+
+class TestEinsumThreeOperands:
+    # lengths around multiples of the vector widths, so that the vector
+    # loops and the scalar loops that finish them off are both used
+    sizes = [1, 3, 7, 8, 15, 16, 17, 31, 33, 63, 64, 65, 127, 130]
+
+    @pytest.mark.parametrize("dtype", [np.int8, np.int16, np.int32,
+                                       np.uint8, np.uint32, np.int64])
+    @pytest.mark.parametrize("n", sizes)
+    def test_integer(self, dtype, n):
+        rng = np.random.RandomState(n)
+        a, b, c = rng.randint(0, 5, size=(3, 4, n)).astype(dtype)
+        # contiguous output, accumulated over the first axis
+        assert_array_equal(np.einsum("ij,ij,ij->j", a, b, c),
+                           (a * b * c).sum(axis=0, dtype=dtype))
+        # contiguous inputs into a scalar output
+        assert_array_equal(np.einsum("i,i,i->", a[0], b[0], c[0]),
+                           (a[0] * b[0] * c[0]).sum(dtype=dtype))
+
+    @pytest.mark.parametrize("dtype", [np.float32, np.float64])
+    @pytest.mark.parametrize("n", sizes)
+    def test_float_rounding(self, dtype, n):
+        # every item is a*b*c + out rounded after each operation, wherever
+        # it falls in the vector and scalar loops
+        rng = np.random.RandomState(n)
+        a, b, c = rng.standard_normal(size=(3, 5, n)).astype(dtype)
+        expected = np.zeros(n, dtype=dtype)
+        for i in range(5):
+            expected = expected + a[i] * b[i] * c[i]
+        assert_array_equal(np.einsum("ij,ij,ij->j", a, b, c), expected)
+
+        res = np.einsum("i,i,i->", a[0], b[0], c[0])
+        assert_allclose(res, (a[0] * b[0] * c[0]).sum(),
+                        rtol=10 * np.finfo(dtype).eps,
+                        atol=10 * n * np.finfo(dtype).eps)
@@ -0,0 +1,185 @@
+""" Test filter_columns against boolean mask indexing.
+
+"""
+import operator
+
+import pytest
+
+import numpy as np
+from numpy.core.multiarray import filter_columns
+from numpy.testing import assert_array_equal, assert_equal, assert_raises
+
+
+OPS = {'<': operator.lt, '<=': operator.le, '==': operator.eq,
+       '!=': operator.ne, '>': operator.gt, '>=': operator.ge}
+
+
+def reference(predicates):
+    mask = np.ones(len(predicates[0][0]), dtype=bool)
+    for column, op, value in predicates:
+        mask &= OPS[op](column, value)
+    return mask
+
+
+class TestFilterColumns:
+    # lengths around the 4096 row blocks of the first pass
+    sizes = [0, 1, 7, 4095, 4096, 4097, 10000]
+    dtypes = [np.int8, np.uint8, np.int16, np.int32, np.uint32, np.int64,
+              np.float16, np.float32, np.float64, np.longdouble]
+
+    @pytest.mark.parametrize("dtype", dtypes)
+    @pytest.mark.parametrize("op", list(OPS))
+    def test_ops(self, dtype, op):
+        rng = np.random.RandomState(48)
+        a = rng.randint(0, 20, size=5000).astype(dtype)
+        b = rng.randint(0, 20, size=5000).astype(dtype)
+        predicates = [(a, op, 9), (b, '>=', 4)]
+        mask = reference(predicates)
+        assert_array_equal(filter_columns(predicates), np.nonzero(mask)[0])
+        res = filter_columns(predicates, [a, b])
+        assert_array_equal(res[0], a[mask])
+        assert_array_equal(res[1], b[mask])
+
+    @pytest.mark.parametrize("n", sizes)
+    def test_sizes(self, n):
+        rng = np.random.RandomState(n)
+        a = rng.standard_normal(n)
+        b = rng.randint(0, 100, size=n)
+        x = rng.randint(-50, 50, size=(n, 3)).astype(np.int32)
+        for predicates in [[(a, '>', 0.5)], [(a, '>', -0.5), (b, '<', 70)],
+                           [(a, '>', 10)], [(a, '<', 10)]]:
+            mask = reference(predicates)
+            idx = filter_columns(predicates)
+            assert_equal(idx.dtype, np.intp)
+            assert_array_equal(idx, np.nonzero(mask)[0])
+
+            res = filter_columns(predicates, [x, a, b])
+            assert isinstance(res, tuple) and len(res) == 3
+            for r, t in zip(res, [x, a, b]):
+                assert_equal(r.dtype, t.dtype)
+                assert_array_equal(r, t[mask])
+
+    def test_mixed_types(self):
+        # compared in the type of column op value, as mask indexing does
+        a = np.arange(-20, 20, dtype=np.int8)
+        b = np.arange(40, dtype=np.uint16)
+        c = np.linspace(-2, 2, 40).astype(np.float32)
+        for predicates in [[(a, '>', 3.5)], [(a, '<', 1000)],
+                           [(b, '>=', 2.5), (c, '<', 1)],
+                           [(c, '==', np.float32(c[7]))],
+                           [(a, '!=', np.int64(-3)), (b, '>', np.int8(4))]]:
+            mask = reference(predicates)
+            assert_array_equal(filter_columns(predicates),
+                               np.nonzero(mask)[0])
+
+    def test_nan(self):
+        a = np.array([1., np.nan, 3., np.nan, -1.])
+        for op in OPS:
+            predicates = [(a, op, 1.)]
+            assert_array_equal(filter_columns(predicates),
+                               np.nonzero(reference(predicates))[0])
+
+    def test_strided_and_byteswapped(self):
+        rng = np.random.RandomState(49)
+        a = rng.randint(0, 100, size=3 * 5000)
+        b = rng.standard_normal(5000)
+        x = rng.standard_normal((5000, 4))
+        columns = [a[::3], a[::-3], a[1::3].astype('>i8'),
+                   a[2::3].astype('>i4')[::1]]
+        for column in columns:
+            for other in [b, b.astype('>f8'), b[::-1]]:
+                predicates = [(column, '>', 40), (other, '<=', 0.3)]
+                mask = reference(predicates)
+                assert_array_equal(filter_columns(predicates),
+                                   np.nonzero(mask)[0])
+                res = filter_columns(predicates, [x[:, 1], x.astype('>f8'),
+                                                  x[::-1]])
+                assert_array_equal(res[0], x[:, 1][mask])
+                assert_array_equal(res[1], x[mask])
+                assert_equal(res[1].dtype, np.dtype('>f8'))
+                assert_array_equal(res[2], x[::-1][mask])
+
+        # a byte-swapped value
+        predicates = [(a, '<', np.array(30, dtype='>i8'))]
+        assert_array_equal(filter_columns(predicates),
+                           np.nonzero(reference(predicates))[0])
+
+    def test_object_targets(self):
+        n = 5000
+        a = np.arange(n)
+        objs = np.empty(n, dtype=object)
+        objs[:] = [[i] for i in range(n)]
+        strs = np.array([str(i) for i in range(n)], dtype=object)
+        predicates = [(a % 7, '==', 3)]
+        mask = reference(predicates)
+        res = filter_columns(predicates, [objs, strs.reshape(n, 1), a])
+        assert_equal(res[0].dtype, object)
+        assert_array_equal(res[1].ravel(), strs[mask])
+        assert_array_equal(res[2], a[mask])
+        # the same objects, not copies
+        for r, o in zip(res[0], objs[mask]):
+            assert r is o
+        del res
+        for i in range(0, n, 997):
+            assert_equal(objs[i], [i])
+
+    def test_sequences(self):
+        a = np.arange(100)
+        expected = np.arange(51, 100)
+        assert_array_equal(filter_columns(((a, '>', 50),)), expected)
+        assert_array_equal(filter_columns([(list(range(100)), '>', 50)]),
+                           expected)
+        res = filter_columns([(a, '>', 50)], (a, a.tolist()))
+        assert_array_equal(res[0], expected)
+        assert_array_equal(res[1], expected)
+        assert_array_equal(filter_columns([(a, '>', 50)], None), expected)
+        assert_equal(filter_columns([(a, '>', 50)], []), ())
+
+    def test_errors(self):
+        a = np.arange(10)
+        # no predicates, or malformed ones
+        assert_raises(ValueError, filter_columns, [])
+        assert_raises(ValueError, filter_columns, [(a, '>')])
+        assert_raises(ValueError, filter_columns, [[a, '>', 3]])
+        assert_raises(ValueError, filter_columns, [(a, '<>', 3)])
+        assert_raises(ValueError, filter_columns, [(a, operator.gt, 3)])
+        # columns must be 1-d of the same length, and values scalars
+        assert_raises(ValueError, filter_columns, [(a.reshape(2, 5), '>', 3)])
+        assert_raises(ValueError, filter_columns, [(np.int64(3), '>', 3)])
+        assert_raises(ValueError, filter_columns, [(a, '>', [3, 4])])
+        assert_raises(ValueError, filter_columns,
+                      [(a, '>', 3), (a[:9], '<', 8)])
+        # targets must have the rows of the columns
+        assert_raises(ValueError, filter_columns, [(a, '>', 3)], [a[:9]])
+        assert_raises(ValueError, filter_columns, [(a, '>', 3)],
+                      [np.int64(1)])
+        # unsupported comparison types
+        for column in [a.astype(complex), a.astype(object),
+                       a.astype('U2'), a.astype('m8[s]')]:
+            assert_raises(TypeError, filter_columns, [(column, '>', 3)])
+        assert_raises(TypeError, filter_columns, [(a, '>', 'x')])
+
+    def test_iterators(self):
+        # iterators are refused without being read by the dispatcher
+        a = np.arange(10)
+        preds = iter([(a, '>', 3)])
+        assert_raises(TypeError, filter_columns, preds)
+        assert_equal(len(list(preds)), 1)
+        assert_raises(TypeError, filter_columns, ((a, '>', 3) for _ in [0]))
+        targets = iter([a])
+        assert_raises(TypeError, filter_columns, [(a, '>', 3)], targets)
+        assert_equal(len(list(targets)), 1)
+        assert_raises(TypeError, filter_columns, 3)
+        assert_raises(TypeError, filter_columns, [(a, '>', 3)], 3)
+
+    def test_array_function(self):
+        # every column and target takes part in the dispatch
+        class Dispatched:
+            def __array_function__(self, func, types, args, kwargs):
+                return 'dispatched'
+
+        a = np.arange(10)
+        d = Dispatched()
+        assert_equal(filter_columns([(a, '>', 3), (d, '<', 4)]),
+                     'dispatched')
+        assert_equal(filter_columns([(a, '>', 3)], [a, d]), 'dispatched')
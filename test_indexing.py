@@ -0,0 +1,167 @@
+""" Test integer indexing with strided, sorted and run-like index arrays.
+
+"""
+import pytest
+
+import numpy as np
+from numpy.testing import assert_array_equal, assert_raises
+
+
+def runs(starts, length):
+    return np.concatenate([np.arange(s, s + length) for s in starts])
+
+
+def almost_sorted(ind, pos):
+    ind = ind.copy()
+    ind[pos], ind[pos + 1] = ind[pos + 1], ind[pos]
+    return ind
+
+
+class TestIndexPatterns:
+    # index arrays recognized as strided, as sorted runs or as sorted are
+    # copied without per-index bounds checks; the others, and those with
+    # a negative or invalid index, go through the regular loops
+    n = 2000
+
+    def patterns(self):
+        rng = np.random.RandomState(49)
+        n = self.n
+        sorted_ind = np.sort(rng.randint(0, n, size=700))
+        return [
+            np.arange(n),
+            np.arange(3, n, 7),
+            np.arange(n - 1, -1, -3),
+            np.full(300, 17),
+            np.arange(5, 6),
+            np.array([4, 9]),
+            runs([0, 40, 100, 1000, 1500], 37),
+            runs([1900, 10, 500], 20),
+            runs([3, 3, 50], 30),
+            sorted_ind,
+            almost_sorted(sorted_ind, 1),
+            almost_sorted(sorted_ind, 400),
+            almost_sorted(sorted_ind, 698),
+            almost_sorted(np.arange(n), 1000),
+            rng.randint(0, n, size=700),
+        ]
+
+    @pytest.mark.parametrize("dtype", [np.int8, np.int32, np.int64,
+                                       np.float64, np.complex128, 'S5',
+                                       object])
+    def test_get(self, dtype):
+        a = np.arange(self.n).astype(dtype)
+        for ind in self.patterns():
+            expected = np.array([a[i] for i in ind.tolist()], dtype=dtype)
+            assert_array_equal(a[ind], expected)
+            assert_array_equal(a[ind.astype(np.int32)], expected)
+            assert_array_equal(a[::-1][ind], a[::-1][ind.tolist()])
+            b = np.zeros(2 * self.n, dtype=dtype)
+            b[::2] = a
+            assert_array_equal(b[::2][ind], expected)
+            assert_array_equal(np.take(a, ind), expected)
+
+    @pytest.mark.parametrize("dtype", [np.int8, np.int32, np.int64,
+                                       np.float64, np.complex128, object])
+    def test_set(self, dtype):
+        for ind in self.patterns():
+            values = np.arange(-1, -1 - len(ind), -1).astype(dtype)
+            expected = np.arange(self.n).astype(dtype)
+            for i, v in zip(ind.tolist(), values):
+                # a repeated index gets the last value
+                expected[i] = v
+            a = np.arange(self.n).astype(dtype)
+            a[ind] = values
+            assert_array_equal(a, expected)
+
+            b = np.zeros(2 * self.n, dtype=dtype)
+            b[::2] = np.arange(self.n)
+            b[::2][ind] = values
+            assert_array_equal(b[::2], expected)
+
+            a = np.arange(self.n).astype(dtype)
+            a[ind] = values[0]
+            assert_array_equal(a[ind], np.full(len(ind), values[0]))
+
+    def test_overlapping_set(self):
+        # the values are the array itself, shifted along a run
+        a = np.arange(100)
+        ind = np.arange(10, 90)
+        a[ind] = a[ind - 5]
+        assert_array_equal(a, np.r_[0:10, 5:85, 90:100])
+        a = np.arange(100)
+        a[ind[::-1]] = a[ind[::-1] + 5]
+        assert_array_equal(a, np.r_[0:10, 15:95, 90:100])
+
+    def test_negative(self):
+        # negative indices are left to the regular loops, which wrap them
+        n = self.n
+        a = np.arange(n)
+        for ind in [np.arange(-n, 0), np.arange(-1, -n - 1, -1),
+                    np.arange(-10, 10), np.arange(-20, n - 20, 3),
+                    runs([-500, -100, 0], 50), np.full(10, -1)]:
+            expected = np.array([a[i] for i in ind.tolist()])
+            assert_array_equal(a[ind], expected)
+
+            b = a.copy()
+            b[ind] = -ind
+            c = a.copy()
+            for i in ind.tolist():
+                c[i] = -i
+            assert_array_equal(b, c)
+
+    def test_out_of_bounds(self):
+        n = self.n
+        a = np.arange(n)
+        sorted_ind = np.sort(np.random.RandomState(50).randint(0, n, 700))
+        bad = [
+            np.arange(n + 1),
+            np.arange(1, n + 1),
+            np.arange(n, 0, -1),
+            np.arange(-n - 1, 0),
+            np.arange(3, n + 7, 7),
+            np.arange(-n - 3, n, 7),
+            np.full(300, n),
+            np.full(300, -n - 1),
+            runs([0, 40, n - 30], 37),
+            runs([-n - 10, 0, 100], 37),
+            np.append(sorted_ind, n),
+            np.insert(sorted_ind, 0, -n - 1),
+            almost_sorted(np.append(sorted_ind, n), 300),
+            np.append(almost_sorted(sorted_ind, 300), n),
+            # steps that wrap around modulo 2**64 between valid endpoints
+            np.array([1, 1 - 2**63, 1]),
+            np.array([0, 2**62, -2**63, -2**62, 0]),
+            np.array([0, 2**63 - 1, 0]),
+        ]
+        for ind in bad:
+            assert_raises(IndexError, a.__getitem__, ind)
+            assert_raises(IndexError, np.take, a, ind)
+            b = a.copy()
+            assert_raises(IndexError, b.__setitem__, ind, 0)
+            # nothing is written before the indices are checked
+            assert_array_equal(b, a)
+
+    def test_multiple_indices(self):
+        # subspaces and several index arrays are checked beforehand by
+        # the MapIter
+        n = self.n
+        a = np.arange(3 * n).reshape(n, 3)
+        for ind in self.patterns():
+            expected = np.array([a[i] for i in ind.tolist()])
+            assert_array_equal(a[ind], expected)
+            assert_array_equal(a[ind, 1], expected[:, 1])
+            assert_array_equal(a[ind, ind % 3], expected[np.arange(len(ind)),
+                                                         ind % 3])
+            b = a.copy()
+            b[ind, 2] = -1
+            assert np.all(b[ind, 2] == -1)
+            assert_array_equal(b[:, :2], a[:, :2])
+
+        for ind in [np.arange(n + 1), np.arange(-n - 1, 0),
+                    runs([0, n - 10], 20), np.array([1, 1 - 2**63, 1])]:
+            assert_raises(IndexError, a.__getitem__, (ind, 1))
+            assert_raises(IndexError, a.__getitem__, ind)
+            b = a.copy()
+            assert_raises(IndexError, b.__setitem__, (ind, 0), 0)
+            assert_raises(IndexError, b.__setitem__, ind, 0)
+            assert_array_equal(b, a)
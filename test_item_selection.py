@@ -0,0 +1,225 @@
+""" Test take, put and integer indexing against plain Python loops.
+
+"""
+import pytest
+
+import numpy as np
+from numpy.testing import assert_array_equal, assert_raises
+
+
+def unaligned(a):
+    buf = np.zeros(a.nbytes + 1, dtype=np.uint8)
+    res = buf[1:].view(a.dtype).reshape(a.shape)
+    res[...] = a
+    return res
+
+
+class TestGatherScatter:
+    # 4 and 8 byte items are gathered and scattered by vector kernels of 4
+    # or 8 indices, with the scalar loop finishing off the rest
+    dtypes = [np.int32, np.float32, np.int64, np.float64, np.complex64]
+    sizes = [1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33]
+
+    def indices(self, n, m, seed):
+        # a mix of positive and negative indices into m items
+        rng = np.random.RandomState(seed)
+        return rng.randint(-m, m, size=n).astype(np.intp)
+
+    @pytest.mark.parametrize("dtype", dtypes)
+    @pytest.mark.parametrize("n", sizes)
+    def test_take(self, dtype, n):
+        a = np.arange(50).astype(dtype)
+        ind = self.indices(n, 50, n)
+        expected = np.array([a[i] for i in ind.tolist()], dtype=dtype)
+        assert_array_equal(np.take(a, ind), expected)
+        assert_array_equal(a[ind], expected)
+        assert_array_equal(np.take(unaligned(a), ind), expected)
+        assert_array_equal(unaligned(a)[ind], expected)
+
+        out = np.empty(n, dtype=dtype)
+        np.take(a, ind, out=out)
+        assert_array_equal(out, expected)
+
+    @pytest.mark.parametrize("n", sizes)
+    def test_take_rows(self, n):
+        # rows of two 4 byte items are gathered as 8 byte chunks
+        a = np.arange(100, dtype=np.int32).reshape(50, 2)
+        ind = self.indices(n, 50, n)
+        expected = np.array([a[i] for i in ind.tolist()]).reshape(n, 2)
+        assert_array_equal(np.take(a, ind, axis=0), expected)
+        assert_array_equal(a[ind], expected)
+
+        # one chunk per outer item along the last axis
+        b = np.arange(150, dtype=np.int64).reshape(3, 50)
+        expected = np.array([[row[i] for i in ind.tolist()] for row in b])
+        assert_array_equal(np.take(b, ind, axis=1), expected)
+        assert_array_equal(b[:, ind], expected)
+
+    @pytest.mark.parametrize("dtype", dtypes)
+    @pytest.mark.parametrize("n", sizes)
+    def test_put(self, dtype, n):
+        ind = self.indices(n, 50, n)
+        values = np.arange(100, 100 + n).astype(dtype)
+        expected = np.arange(50).astype(dtype)
+        for i, v in zip(ind.tolist(), values):
+            # with repeated indices the last value wins
+            expected[i] = v
+
+        a = np.arange(50).astype(dtype)
+        np.put(a, ind, values)
+        assert_array_equal(a, expected)
+
+        a = np.arange(50).astype(dtype)
+        a[ind] = values
+        assert_array_equal(a, expected)
+
+        a = unaligned(np.arange(50).astype(dtype))
+        np.put(a, ind, values)
+        assert_array_equal(a, expected)
+
+    @pytest.mark.parametrize("dtype", [np.int32, np.float64])
+    @pytest.mark.parametrize("n", sizes)
+    def test_modes(self, dtype, n):
+        # wrap and clip keep the scalar loops, but must agree with them
+        a = np.arange(50).astype(dtype)
+        ind = self.indices(n, 200, n)
+        for mode, fix in [("wrap", lambda i: i % 50),
+                          ("clip", lambda i: min(max(i, 0), 49))]:
+            expected = np.array([a[fix(i)] for i in ind.tolist()],
+                                dtype=dtype)
+            assert_array_equal(np.take(a, ind, mode=mode), expected)
+
+            values = np.arange(100, 100 + n).astype(dtype)
+            expected = a.copy()
+            for i, v in zip(ind.tolist(), values):
+                expected[fix(i)] = v
+            b = a.copy()
+            np.put(b, ind, values, mode=mode)
+            assert_array_equal(b, expected)
+
+    @pytest.mark.parametrize("dtype", [np.int32, np.int64])
+    @pytest.mark.parametrize("n", sizes)
+    def test_out_of_bounds(self, dtype, n):
+        # an invalid index in every position of the vectors and the tail
+        a = np.arange(50).astype(dtype)
+        for pos in range(n):
+            for bad in [50, -51, np.iinfo(np.intp).max,
+                        np.iinfo(np.intp).min]:
+                ind = self.indices(n, 50, n)
+                ind[pos] = bad
+                assert_raises(IndexError, np.take, a, ind)
+                assert_raises(IndexError, a.__getitem__, ind)
+
+                # the items before the invalid index are written
+                b = a.copy()
+                values = np.arange(100, 100 + n).astype(dtype)
+                assert_raises(IndexError, np.put, b, ind, values)
+                expected = a.copy()
+                for i, v in zip(ind[:pos].tolist(), values):
+                    expected[i] = v
+                assert_array_equal(b, expected)
+
+                b = a.copy()
+                assert_raises(IndexError, b.__setitem__, ind, values)
+
+    @pytest.mark.parametrize("dtype", [np.int32, np.int64])
+    def test_large(self, dtype):
+        # indexed data over 1 MiB, which is prefetched
+        a = np.arange(1 << 19).astype(dtype)
+        ind = self.indices(1001, a.size, 1)
+        expected = np.array([a[i] for i in ind.tolist()], dtype=dtype)
+        assert_array_equal(np.take(a, ind), expected)
+        assert_array_equal(a[ind], expected)
+
+        values = -np.arange(1001).astype(dtype)
+        expected = a.copy()
+        for i, v in zip(ind.tolist(), values):
+            expected[i] = v
+        a[ind] = values
+        assert_array_equal(a, expected)
+
+
+class TestCompress:
+    # masks are read 32 entries at a time, skipping all-false blocks and
+    # copying all-true blocks whole
+    dtypes = [np.int32, np.float32, np.int64, np.float64, np.complex64,
+              np.int16, np.complex128]
+    sizes = [0, 1, 7, 31, 32, 33, 63, 64, 65, 100, 257]
+
+    def masks(self, n):
+        rng = np.random.RandomState(n)
+        blocks = (np.arange(n) // 32) % 2 == 0
+        return [np.ones(n, dtype=bool), np.zeros(n, dtype=bool),
+                rng.rand(n) < 0.5, rng.rand(n) < 0.02, blocks, ~blocks]
+
+    @pytest.mark.parametrize("dtype", dtypes)
+    @pytest.mark.parametrize("n", sizes)
+    def test_select(self, dtype, n):
+        a = np.arange(n).astype(dtype)
+        for mask in self.masks(n):
+            expected = np.array([x for x, m in zip(a, mask) if m],
+                                dtype=dtype)
+            assert_array_equal(a[mask], expected)
+            assert_array_equal(np.compress(mask, a), expected)
+            assert_array_equal(unaligned(a)[mask], expected)
+            assert_array_equal(np.compress(mask, unaligned(a)), expected)
+
+            b = np.zeros(2 * n).astype(dtype)
+            b[::2] = a
+            assert_array_equal(b[::2][mask], expected)
+            assert_array_equal(np.compress(mask, b[::2]), expected)
+
+    @pytest.mark.parametrize("n", sizes)
+    def test_nonzero(self, n):
+        for mask in self.masks(n):
+            expected = np.array([j for j, m in enumerate(mask) if m],
+                                dtype=np.intp)
+            assert_array_equal(np.nonzero(mask)[0], expected)
+            assert_array_equal(np.flatnonzero(mask), expected)
+
+    @pytest.mark.parametrize("n", sizes)
+    def test_strided_mask(self, n):
+        # masks that are not contiguous keep the scalar loops
+        a = np.arange(n, dtype=np.int64)
+        for mask in self.masks(n):
+            strided = np.zeros(2 * n, dtype=bool)
+            strided[1::2] = mask
+            strided = strided[1::2]
+            expected = np.array([x for x, m in zip(a, mask) if m],
+                                dtype=a.dtype)
+            assert_array_equal(a[strided], expected)
+            assert_array_equal(np.compress(strided, a), expected)
+            assert_array_equal(np.nonzero(strided)[0], np.nonzero(mask)[0])
+
+            reversed_mask = mask[::-1].copy()[::-1]
+            assert_array_equal(a[reversed_mask], expected)
+
+    @pytest.mark.parametrize("dtype", [np.int32, np.float64])
+    def test_multidimensional(self, dtype):
+        # the inner loop of the boolean subscript covers a row or the
+        # whole array, and the output is filled across inner loops
+        rng = np.random.RandomState(47)
+        a = np.arange(7 * 45).astype(dtype).reshape(7, 45)
+        for mask in [rng.rand(7, 45) < 0.5, np.ones((7, 45), dtype=bool),
+                     np.zeros((7, 45), dtype=bool)]:
+            expected = np.array([x for x, m in zip(a.ravel(), mask.ravel())
+                                 if m], dtype=dtype)
+            assert_array_equal(a[mask], expected)
+            assert_array_equal(a[:, 3:40][mask[:, 3:40]],
+                               a[:, 3:40].ravel()[mask[:, 3:40].ravel()])
+            f = np.asfortranarray(a)
+            assert_array_equal(f[np.asfortranarray(mask)], expected)
+
+            expected = np.array([[x for x, m in zip(row, mask[0]) if m]
+                                 for row in a], dtype=dtype)
+            assert_array_equal(np.compress(mask[0], a, axis=1),
+                               expected.reshape(7, -1))
+
+    def test_compress_out(self):
+        # an out argument keeps the general path
+        a = np.arange(40, dtype=np.int64)
+        mask = a % 3 == 0
+        out = np.empty(mask.sum(), dtype=np.int64)
+        res = np.compress(mask, a, out=out)
+        assert res is out
+        assert_array_equal(out, a[::3])
@@ -573,6 +573,44 @@ class TestUfunc:
         assert_equal(np.sum([[1., 2.], [3., 4.]], axis=0, initial=5.,
                             where=[True, False]), [9., 5.])
 
+    @pytest.mark.parametrize("axis", [0, 1])
+    def test_sum_pairwise_all_axes(self, axis):
+        # reducing over the outer axis of a C-ordered array must be as
+        # accurate as the contiguous pairwise sum
+        a = np.full((2**18, 3), 0.1, dtype=np.float32)
+        if axis == 1:
+            a = np.ascontiguousarray(a.T)
+        res = a.sum(axis=axis)
+        assert_allclose(res, [0.1 * 2**18] * 3, rtol=1e-5)
+
+    @pytest.mark.parametrize("dt", [np.float32, np.float64, np.longdouble,
+                                    np.complex128])
+    def test_sum_compensated(self, dt):
+        big = np.finfo(dt).max / 4
+        d = np.array([1., big, 1., -big], dtype=dt)
+        assert_equal(np.add.reduce(d, compensated=True), 2.)
+        assert_equal(np.sum(d.reshape(4, 1), axis=0, compensated=True), [2.])
+        assert_equal(np.mean(d, compensated=True), 0.5)
+        assert_equal(np.add.reduce([np.inf, 1.], compensated=True), np.inf)
+
+    def test_sum_compensated_only_add(self):
+        assert_raises(ValueError, np.multiply.reduce, [1., 2.],
+                      compensated=True)
+
+    def test_reduce_other_add(self):
+        # another ufunc named add is neither regrouped nor compensated
+        fake_add = umt.fake_add
+        a = np.arange(100.)
+        assert_equal(fake_add.reduce(a), -4950.)
+        b = np.arange(600.).reshape(100, 6)
+        assert_equal(fake_add.reduce(b, axis=0), b[0] - b[1:].sum(axis=0))
+        assert_equal(fake_add.reduce(b, axis=1), b[:, 0] - b[:, 1:].sum(axis=1))
+        assert_raises(ValueError, fake_add.reduce, a, compensated=True)
+        assert_raises(ValueError, fake_add.reduce, b, axis=0,
+                      compensated=True)
+        # the builtin add still takes it for every type
+        assert_equal(np.add.reduce(np.arange(100), compensated=True), 4950)
+
     def test_inner1d(self):
         a = np.arange(6).reshape((2, 3))
         assert_array_equal(umt.inner1d(a, a), np.sum(a*a, axis=-1))
@@ -1053,6 +1091,39 @@ class TestUfunc:
         res = umt.matrix_multiply(np.ones((10, 0)), np.ones((0, 10)))
         assert_array_equal(res, np.zeros((10, 10)))
 
+    @pytest.mark.parametrize("tp", [np.int32, np.uint32, np.int64,
+                                    np.uint64, np.float32, np.float64])
+    @pytest.mark.parametrize("shape", [(17, 300, 33), (100, 513, 70)])
+    def test_matmul_blocked(self, tp, shape):
+        # large enough for the blocked kernel, with edge tiles, more than one
+        # block along n, and strided or transposed operands and output
+        m, n, p = shape
+        rng = np.random.RandomState(0)
+        a = rng.randint(0, 20, size=(m, 2 * n)).astype(tp)[:, ::2]
+        b = rng.randint(0, 20, size=(p, n)).astype(tp).T
+        expected = umt.matrix_multiply(a, b)
+        assert_array_equal(np.matmul(a, b), expected)
+        out = np.empty((p, m), dtype=tp).T
+        np.matmul(a, b, out=out)
+        assert_array_equal(out, expected)
+        assert_array_equal(np.matmul(np.ascontiguousarray(a),
+                                     np.ascontiguousarray(b)), expected)
+
+    @pytest.mark.parametrize("tp", [np.int8, np.int64, np.float32,
+                                    np.float64, np.longdouble])
+    @pytest.mark.parametrize("shape", [(2, 2, 2), (3, 3, 3), (4, 4, 4),
+                                       (4, 4, 1), (1, 5, 3), (16, 7, 16),
+                                       (3, 0, 2)])
+    def test_matmul_small_stack(self, tp, shape):
+        m, n, p = shape
+        rng = np.random.RandomState(0)
+        a = rng.randint(0, 5, size=(10, m, n)).astype(tp)
+        b = rng.randint(0, 5, size=(10, p, n)).astype(tp).transpose(0, 2, 1)
+        expected = (a[..., None] * b[:, None, :, :]).sum(axis=2, dtype=tp)
+        assert_array_equal(np.matmul(a, b), expected)
+        assert_array_equal(np.matmul(a[::-2], b[::2]),
+                           np.matmul(a[::-2].copy(), b[::2].copy()))
+
     def compare_matrix_multiply_results(self, tp):
         d1 = np.array(np.random.rand(2, 3, 4), dtype=tp)
         d2 = np.array(np.random.rand(2, 3, 4), dtype=tp)
@@ -1789,6 +1860,53 @@ class TestUfunc:
         # Test multiple output ufuncs raise error, gh-5665
         assert_raises(ValueError, np.modf.at, np.arange(10), [1])
 
+    @pytest.mark.parametrize("ufunc", [np.add, np.subtract, np.multiply,
+                                       np.maximum, np.minimum])
+    @pytest.mark.parametrize("dtype", np.typecodes["AllInteger"] + "fdg")
+    def test_ufunc_at_indexed(self, ufunc, dtype):
+        # 1-d operands with a single index array use typed indexed loops
+        rng = np.random.RandomState(ord(dtype))
+        index = rng.randint(-20, 20, size=200)
+        values = rng.randint(1, 4, size=200).astype(dtype)
+        for index_dtype in [np.intp, np.int32]:
+            for b in [values, values[7], values.astype(np.uint8)]:
+                a = np.arange(20, dtype=dtype)
+                expected = a.copy()
+                for i, v in zip(index, np.broadcast_to(b, index.shape)):
+                    expected[i] = ufunc(expected[i], v.astype(dtype))
+                ufunc.at(a, index.astype(index_dtype), b)
+                assert_array_equal(a, expected)
+
+        # strided operand and index, and values overlapping the operand
+        a = np.arange(40, dtype=dtype)
+        expected = a.copy()
+        for i, j in [(3, 1), (6, 2), (3, 3)]:
+            expected[::2][i] = ufunc(expected[::2][i], expected[j])
+        ufunc.at(a[::2], np.array([3, 0, 6, 0, 3])[::2], a[1:4])
+        assert_array_equal(a, expected)
+
+        assert_raises(IndexError, ufunc.at, np.arange(5, dtype=dtype),
+                      [1, 5], 1)
+
+    def test_ufunc_at_indexed_other_add(self):
+        # another ufunc named add keeps its own loop
+        fake_add = umt.fake_add
+        assert_equal(fake_add.__name__, "add")
+        for dtype in ["l", "d"]:
+            a = np.arange(10, dtype=dtype)
+            fake_add.at(a, [1, 1, 5, -1], np.array([2, 3, 4, 5], dtype=dtype))
+            assert_array_equal(a, [0, -4, 2, 3, 4, 1, 6, 7, 8, 4])
+            np.add.at(a, [1, 1, 5, -1], np.array([2, 3, 4, 5], dtype=dtype))
+            assert_array_equal(a, np.arange(10))
+
+    def test_ufunc_at_indexed_nan(self):
+        a = np.array([0., np.nan, 2.])
+        np.maximum.at(a, [0, 0, 1, 2], [np.nan, 5., 1., 3.])
+        assert_array_equal(a, [np.nan, np.nan, 3.])
+        a = np.array([0., np.nan, 2.])
+        np.minimum.at(a, [0, 1, 2, 2], [-1., 1., np.nan, 0.])
+        assert_array_equal(a, [-1., np.nan, np.nan])
+
     def test_reduce_arguments(self):
         f = np.add.reduce
         d = np.ones((5,2), dtype=int)
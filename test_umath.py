@@ -915,6 +915,25 @@ class TestAVXFloat32Transcendental:
                 assert_array_almost_equal_nulp(np.sin(x_f32_large[::jj]), sin_true[::jj], nulp=2)
                 assert_array_almost_equal_nulp(np.cos(x_f32_large[::jj]), cos_true[::jj], nulp=2)
 
+class TestHalfArithmetic:
+    @pytest.mark.parametrize("func", [np.add, np.subtract,
+                                      np.multiply, np.true_divide])
+    def test_half_matches_float(self, func):
+        np.random.seed(42)
+        strides = [-3, -1, 1, 2, 3]
+        for size in [1, 7, 8, 9, 255, 256, 257, 1000]:
+            a = np.random.uniform(-100, 100, size=size).astype(np.float16)
+            b = np.random.uniform(0.5, 100, size=size).astype(np.float16)
+            expected = func(a.astype(np.float32),
+                            b.astype(np.float32)).astype(np.float16)
+            assert_equal(func(a, b), expected)
+            for jj in strides:
+                assert_equal(func(a[::jj], b[::jj]), expected[::jj])
+            # in-place operation converts complete blocks before writing
+            out = a.copy()
+            func(out, b, out=out)
+            assert_equal(out, expected)
+
 class TestLogAddExp(_FilterInvalids):
     def test_logaddexp_values(self):
         x = [1, 2, 3, 4, 5]
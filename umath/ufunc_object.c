@@ -23,6 +23,7 @@
 #include "extobj.h"
 #include "common.h"
 #include "numpyos.h"
+#include "loops.h"
 
 /********** PRINTF DEBUG TRACING **************/
 #define NPY_UF_DBG_TRACING 0
@@ -3425,13 +3426,344 @@ reduce_type_resolver(PyUFuncObject *ufunc, PyArrayObject *arr,
     return 0;
 }
 
+/*
+ * Partial sums for add.reduce over inexact types.
+ *
+ * The inner loop only ever sees one row of the reduction, so when the
+ * reduced axis is not the innermost one every row is added straight into
+ * the output and the rounding error grows linearly with the number of rows.
+ * Rows headed for the same output block are instead summed into a cascade
+ * of scratch buffers, level k holding REDUCE_CASCADE_ROWS * 2**(k-1) rows,
+ * which is the pairing the pairwise summation in loops.c.src uses along the
+ * inner axis. The row additions themselves go through the selected (SIMD)
+ * add loop. When the reduced axis is innermost, each chunk handed to the
+ * loop is already summed pairwise and the chunks go through the cascade.
+ *
+ * With compensated=True the rows are added with Neumaier compensation
+ * instead, keeping one error term per output element.
+ */
+#define REDUCE_CASCADE_ROWS 16
+#define REDUCE_CASCADE_LEVELS 48
+/* Cap on the scratch memory; wider outputs use plain accumulation */
+#define REDUCE_CASCADE_MAXBYTES (8 * 1024 * 1024)
+
+typedef struct {
+    PyUFuncObject *ufunc;
+    int compensated;
+} reduce_loop_data;
+
+typedef struct {
+    PyUFuncGenericFunction add, add_compensated;
+    void *add_data;
+    npy_intp itemsize;
+    /* The output block the pending partial sums belong to */
+    char *out;
+    npy_intp out_stride, width;
+    /* Scratch buffers of `capacity` items */
+    npy_intp capacity;
+    int maxlevels;
+    npy_intp rows[REDUCE_CASCADE_LEVELS];
+    char *levels[REDUCE_CASCADE_LEVELS];
+    char *comp;
+} reduce_cascade;
+
+/*
+ * The inner loops and loop data of add for every type, recorded when umath
+ * is set up. Summation is only regrouped or compensated for these, so that
+ * another ufunc named add, or a replaced loop, is reduced as it is.
+ */
+static struct {
+    PyUFuncGenericFunction func;
+    void *data;
+} builtin_add_loops[NPY_NTYPES];
+
+NPY_NO_EXPORT int
+init_reduce_add_loops(PyObject *d)
+{
+    PyObject *obj = PyDict_GetItemString(d, "add");
+    PyUFuncObject *ufunc;
+    int j;
+
+    if (obj == NULL || !PyObject_TypeCheck(obj, &PyUFunc_Type)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                "cannot find the ufunc add while initializing "
+                "_multiarray_umath.");
+        return -1;
+    }
+    ufunc = (PyUFuncObject *)obj;
+    for (j = 0; j < ufunc->ntypes; j++) {
+        const char *types = ufunc->types + j * ufunc->nargs;
+        const int t = types[0];
+
+        if (t >= 0 && t < NPY_NTYPES && types[1] == t && types[2] == t) {
+            builtin_add_loops[t].func = ufunc->functions[j];
+            builtin_add_loops[t].data = ufunc->data[j];
+        }
+    }
+    return 0;
+}
+
+static int
+is_builtin_add_loop(PyUFuncGenericFunction innerloop, void *innerloopdata,
+                    int type_num)
+{
+    return type_num >= 0 && type_num < NPY_NTYPES && innerloop != NULL &&
+           innerloop == builtin_add_loops[type_num].func &&
+           innerloopdata == builtin_add_loops[type_num].data;
+}
+
+static PyUFuncGenericFunction
+compensated_add_loop(int type_num)
+{
+    switch (type_num) {
+        case NPY_FLOAT: return &FLOAT_add_compensated;
+        case NPY_DOUBLE: return &DOUBLE_add_compensated;
+        case NPY_LONGDOUBLE: return &LONGDOUBLE_add_compensated;
+        case NPY_CFLOAT: return &CFLOAT_add_compensated;
+        case NPY_CDOUBLE: return &CDOUBLE_add_compensated;
+        case NPY_CLONGDOUBLE: return &CLONGDOUBLE_add_compensated;
+    }
+    return NULL;
+}
+
+/* Adds the contiguous buffer `buf` into the output block */
+static void
+reduce_cascade_add_to_out(reduce_cascade *c, char *buf)
+{
+    char *args[3] = {c->out, buf, c->out};
+    npy_intp steps[3] = {c->out_stride, c->itemsize, c->out_stride};
+    c->add(args, &c->width, steps, c->add_data);
+}
+
+/* Adds `src` into `dst`, both contiguous scratch buffers */
+static void
+reduce_cascade_merge(reduce_cascade *c, char *dst, char *src)
+{
+    char *args[3] = {dst, src, dst};
+    npy_intp steps[3] = {c->itemsize, c->itemsize, c->itemsize};
+    c->add(args, &c->width, steps, c->add_data);
+}
+
+static void
+reduce_cascade_flush(reduce_cascade *c)
+{
+    int k;
+    char *sum = NULL;
+
+    if (c->out == NULL) {
+        return;
+    }
+    if (c->add_compensated != NULL) {
+        reduce_cascade_add_to_out(c, c->comp);
+    }
+    else {
+        for (k = 0; k < c->maxlevels; k++) {
+            if (c->rows[k] == 0) {
+                continue;
+            }
+            if (sum == NULL) {
+                sum = c->levels[k];
+            }
+            else {
+                reduce_cascade_merge(c, sum, c->levels[k]);
+            }
+            c->rows[k] = 0;
+        }
+        if (sum != NULL) {
+            reduce_cascade_add_to_out(c, sum);
+        }
+    }
+    c->out = NULL;
+}
+
+static void
+reduce_cascade_free(reduce_cascade *c)
+{
+    int k;
+    for (k = 0; k < REDUCE_CASCADE_LEVELS; k++) {
+        PyArray_free(c->levels[k]);
+        c->levels[k] = NULL;
+    }
+    PyArray_free(c->comp);
+    c->comp = NULL;
+    c->capacity = 0;
+}
+
+/*
+ * Starts accumulating for a new output block of `width` items. Returns 0
+ * if the block is empty or too wide or the scratch memory could not be
+ * allocated, in which case the caller falls back to the plain inner loop.
+ */
+static int
+reduce_cascade_start(reduce_cascade *c, char *out, npy_intp out_stride,
+                     npy_intp width)
+{
+    npy_intp nbytes = width * c->itemsize;
+
+    /* zero-sized items or an empty block leave nothing to accumulate */
+    if (nbytes == 0) {
+        return 0;
+    }
+    if (c->add_compensated == NULL &&
+            nbytes * 2 > REDUCE_CASCADE_MAXBYTES) {
+        return 0;
+    }
+    if (width > c->capacity) {
+        reduce_cascade_free(c);
+        if (c->add_compensated != NULL) {
+            c->comp = PyArray_malloc(nbytes);
+            if (c->comp == NULL) {
+                return 0;
+            }
+        }
+        else {
+            c->levels[0] = PyArray_malloc(nbytes);
+            if (c->levels[0] == NULL) {
+                return 0;
+            }
+        }
+        c->capacity = width;
+    }
+    c->maxlevels = (int)NPY_MIN(REDUCE_CASCADE_LEVELS,
+                                REDUCE_CASCADE_MAXBYTES / nbytes);
+    c->out = out;
+    c->out_stride = out_stride;
+    c->width = width;
+    /* all-zero bits are +0.0, the identity of add */
+    memset(c->add_compensated != NULL ? c->comp : c->levels[0], 0, nbytes);
+    return 1;
+}
+
+/*
+ * Sums `count` items of the operand into the current block. If scratch
+ * memory runs out the block is flushed to the output early.
+ */
+static void
+reduce_cascade_row(reduce_cascade *c, char *in, npy_intp in_stride,
+                   npy_intp count)
+{
+    npy_intp nbytes = c->width * c->itemsize;
+    npy_intp steps[3];
+    char *args[3];
+    int k;
+
+    if (c->add_compensated != NULL) {
+        args[0] = c->out;
+        args[1] = in;
+        args[2] = c->comp;
+        steps[0] = c->out_stride;
+        steps[1] = in_stride;
+        steps[2] = c->out_stride == 0 ? 0 : c->itemsize;
+        c->add_compensated(args, &count, steps, NULL);
+        return;
+    }
+
+    args[0] = c->levels[0];
+    args[1] = in;
+    args[2] = c->levels[0];
+    steps[0] = steps[2] = c->out_stride == 0 ? 0 : c->itemsize;
+    steps[1] = in_stride;
+    c->add(args, &count, steps, c->add_data);
+    if (++c->rows[0] < REDUCE_CASCADE_ROWS) {
+        return;
+    }
+
+    /* Carry the full block up, merging equally sized levels on the way */
+    for (k = 1; k < c->maxlevels - 1 && c->rows[k] != 0; k++) {
+        reduce_cascade_merge(c, c->levels[0], c->levels[k]);
+        c->rows[0] += c->rows[k];
+        c->rows[k] = 0;
+    }
+    if (k == c->maxlevels - 1 && c->rows[k] != 0) {
+        /* out of levels, the top one keeps growing */
+        reduce_cascade_merge(c, c->levels[k], c->levels[0]);
+        c->rows[k] += c->rows[0];
+    }
+    else {
+        char *tmp;
+        if (c->levels[k] == NULL) {
+            c->levels[k] = PyArray_malloc(c->capacity * c->itemsize);
+            if (c->levels[k] == NULL) {
+                reduce_cascade_flush(c);
+                return;
+            }
+        }
+        tmp = c->levels[k];
+        c->levels[k] = c->levels[0];
+        c->levels[0] = tmp;
+        c->rows[k] = c->rows[0];
+    }
+    c->rows[0] = 0;
+    memset(c->levels[0], 0, nbytes);
+}
+
+/*
+ * Reduction loop for add over inexact types without a where mask,
+ * see reduce_cascade above.
+ */
+static void
+reduce_loop_cascade(reduce_cascade *c, char **dataptrs,
+                    npy_intp const *strides, npy_intp const *countptr,
+                    NpyIter *iter, NpyIter_IterNextFunc *iternext,
+                    int buffered)
+{
+    char *dataptrs_copy[3];
+    npy_intp strides_copy[3];
+    /* The last output block that was added to directly */
+    char *seen = NULL;
+    npy_intp seen_stride = 0, seen_width = 0;
+
+    do {
+        npy_intp count = *countptr;
+        npy_intp width = strides[0] == 0 ? 1 : count;
+
+        if (c->out != NULL && dataptrs[0] == c->out &&
+                strides[0] == c->out_stride && width == c->width) {
+            reduce_cascade_row(c, dataptrs[1], strides[1], count);
+            continue;
+        }
+        reduce_cascade_flush(c);
+        /*
+         * Blocks visited only once gain nothing from the scratch buffers,
+         * so the cascade starts on the second visit in a row (right away
+         * in compensated mode).
+         */
+        if ((c->add_compensated != NULL ||
+                (dataptrs[0] == seen && strides[0] == seen_stride &&
+                 width == seen_width)) &&
+                reduce_cascade_start(c, dataptrs[0], strides[0], width)) {
+            reduce_cascade_row(c, dataptrs[1], strides[1], count);
+            if (buffered) {
+                reduce_cascade_flush(c);
+            }
+            continue;
+        }
+        seen = dataptrs[0];
+        seen_stride = strides[0];
+        seen_width = width;
+
+        /* Turn the two items into three for the inner loop */
+        dataptrs_copy[0] = dataptrs[0];
+        dataptrs_copy[1] = dataptrs[1];
+        dataptrs_copy[2] = dataptrs[0];
+        strides_copy[0] = strides[0];
+        strides_copy[1] = strides[1];
+        strides_copy[2] = strides[0];
+        c->add(dataptrs_copy, &count, strides_copy, c->add_data);
+    } while (iternext(iter));
+
+    reduce_cascade_flush(c);
+    reduce_cascade_free(c);
+}
+
 static int
 reduce_loop(NpyIter *iter, char **dataptrs, npy_intp const *strides,
             npy_intp const *countptr, NpyIter_IterNextFunc *iternext,
             int needs_api, npy_intp skip_first_count, void *data)
 {
     PyArray_Descr *dtypes[3], **iter_dtypes;
-    PyUFuncObject *ufunc = (PyUFuncObject *)data;
+    PyUFuncObject *ufunc = ((reduce_loop_data *)data)->ufunc;
+    int compensated = ((reduce_loop_data *)data)->compensated;
     char *dataptrs_copy[3];
     npy_intp strides_copy[3];
     npy_bool masked;
@@ -3456,6 +3788,34 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp const *strides,
 
     NPY_BEGIN_THREADS_NDITER(iter);
 
+    if (!masked && skip_first_count == 0 &&
+            (PyDataType_ISFLOAT(dtypes[0]) ||
+             PyDataType_ISCOMPLEX(dtypes[0])) &&
+            is_builtin_add_loop(innerloop, innerloopdata,
+                                dtypes[0]->type_num)) {
+        reduce_cascade cascade;
+        /*
+         * The cascade keys its partial sums on the output pointer, which
+         * is only safe while no operand goes through the iterator's
+         * buffers. Otherwise only the compensation within each inner loop
+         * call is kept.
+         */
+        int buffered = NpyIter_RequiresBuffering(iter);
+
+        memset(&cascade, 0, sizeof(cascade));
+        cascade.add = innerloop;
+        cascade.add_data = innerloopdata;
+        cascade.itemsize = dtypes[0]->elsize;
+        if (compensated) {
+            cascade.add_compensated = compensated_add_loop(dtypes[0]->type_num);
+        }
+        if (!buffered || cascade.add_compensated != NULL) {
+            reduce_loop_cascade(&cascade, dataptrs, strides, countptr,
+                                iter, iternext, buffered);
+            goto finish_loop;
+        }
+    }
+
     if (skip_first_count > 0) {
         do {
             npy_intp count = *countptr;
@@ -3560,7 +3920,7 @@ finish_loop:
 static PyArrayObject *
 PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
         int naxes, int *axes, PyArray_Descr *odtype, int keepdims,
-        PyObject *initial, PyArrayObject *wheremask)
+        PyObject *initial, PyArrayObject *wheremask, int compensated)
 {
     int iaxes, ndim;
     npy_bool reorderable;
@@ -3572,6 +3932,7 @@ PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
     /* These parameters come from a TLS global */
     int buffersize = 0, errormask = 0;
     static PyObject *NoValue = NULL;
+    reduce_loop_data loop_data = {ufunc, compensated};
 
     NPY_UF_DBG_PRINT1("\nEvaluating ufunc %s.reduce\n", ufunc_name);
 
@@ -3626,13 +3987,37 @@ PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
         return NULL;
     }
 
+    if (compensated) {
+        PyArray_Descr *dtypes[3] = {dtype, dtype, dtype};
+        PyUFuncGenericFunction innerloop = NULL;
+        void *innerloopdata = NULL;
+        int needs_api = 0;
+
+        if (ufunc->legacy_inner_loop_selector(ufunc, dtypes,
+                        &innerloop, &innerloopdata, &needs_api) < 0) {
+            Py_DECREF(dtype);
+            Py_DECREF(initial);
+            return NULL;
+        }
+        if (!is_builtin_add_loop(innerloop, innerloopdata,
+                                 dtype->type_num)) {
+            PyErr_Format(PyExc_ValueError,
+                    "compensated summation is only supported by the "
+                    "builtin add.reduce, not %s.reduce for %S",
+                    ufunc_name, (PyObject *)dtype);
+            Py_DECREF(dtype);
+            Py_DECREF(initial);
+            return NULL;
+        }
+    }
+
     result = PyUFunc_ReduceWrapper(arr, out, wheremask, dtype, dtype,
                                    NPY_UNSAFE_CASTING,
                                    axis_flags, reorderable,
                                    keepdims,
                                    initial,
                                    reduce_loop,
-                                   ufunc, buffersize, ufunc_name, errormask);
+                                   &loop_data, buffersize, ufunc_name, errormask);
 
     Py_DECREF(dtype);
     Py_DECREF(initial);
@@ -4389,8 +4774,10 @@ PyUFunc_GenericReduction(PyUFuncObject *ufunc, PyObject *args,
     PyArrayObject *out = NULL;
     int keepdims = 0;
     PyObject *initial = NULL;
+    int compensated = 0;
     static char *reduce_kwlist[] = {
-        "array", "axis", "dtype", "out", "keepdims", "initial", "where", NULL};
+        "array", "axis", "dtype", "out", "keepdims", "initial", "where",
+        "compensated", NULL};
     static char *accumulate_kwlist[] = {
             "array", "axis", "dtype", "out", NULL};
     static char *reduceat_kwlist[] = {
@@ -4465,14 +4852,15 @@ PyUFunc_GenericReduction(PyUFuncObject *ufunc, PyObject *args,
         }
     }
     else {
-        if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO&O&iOO&:reduce",
+        if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO&O&iOO&$p:reduce",
                                          reduce_kwlist,
                                          &op,
                                          &axes_in,
                                          PyArray_DescrConverter2, &otype,
                                          PyArray_OutputConverter, &out,
                                          &keepdims, &initial,
-                                         _wheremask_converter, &wheremask)) {
+                                         _wheremask_converter, &wheremask,
+                                         &compensated)) {
             goto fail;
         }
     }
@@ -4590,7 +4978,7 @@ PyUFunc_GenericReduction(PyUFuncObject *ufunc, PyObject *args,
     switch(operation) {
     case UFUNC_REDUCE:
         ret = PyUFunc_Reduce(ufunc, mp, out, naxes, axes,
-                             otype, keepdims, initial, wheremask);
+                             otype, keepdims, initial, wheremask, compensated);
         Py_XDECREF(wheremask);
         break;
     case UFUNC_ACCUMULATE:
@@ -5554,7 +5942,154 @@ ufunc_reduceat(PyUFuncObject *ufunc, PyObject *args, PyObject *kwds)
     return PyUFunc_GenericReduction(ufunc, args, kwds, UFUNC_REDUCEAT);
 }
 
-/* Helper for ufunc_at, below */
+/* Helpers for ufunc_at, below */
+#define NPY_INDEXED_KINDS 5
+/* NPY_BYTE through NPY_LONGDOUBLE are consecutive */
+#define NPY_INDEXED_TYPES (NPY_LONGDOUBLE - NPY_BYTE + 1)
+
+/*
+ * The inner loops that add, subtract, multiply, maximum and minimum have
+ * for every type when umath is set up, after the SIMD loops are chosen.
+ * An indexed loop is only used in place of the very same inner loop, so
+ * that neither another ufunc of the same name nor a replaced loop is
+ * mistaken for a builtin one.
+ */
+static PyUFuncGenericFunction
+indexed_builtin_loops[NPY_INDEXED_TYPES][NPY_INDEXED_KINDS];
+
+NPY_NO_EXPORT int
+init_indexed_loops(PyObject *d)
+{
+    static const char *const kinds[NPY_INDEXED_KINDS] = {
+        "add", "subtract", "multiply", "maximum", "minimum"};
+    int j, k;
+
+    for (k = 0; k < NPY_INDEXED_KINDS; k++) {
+        PyObject *obj = PyDict_GetItemString(d, kinds[k]);
+        PyUFuncObject *ufunc;
+
+        if (obj == NULL || !PyObject_TypeCheck(obj, &PyUFunc_Type)) {
+            PyErr_Format(PyExc_RuntimeError,
+                    "cannot find the ufunc %s while initializing "
+                    "_multiarray_umath.", kinds[k]);
+            return -1;
+        }
+        ufunc = (PyUFuncObject *)obj;
+        for (j = 0; j < ufunc->ntypes; j++) {
+            const char *types = ufunc->types + j * ufunc->nargs;
+            const int t = types[0];
+
+            if (t >= NPY_BYTE && t <= NPY_LONGDOUBLE &&
+                    types[1] == t && types[2] == t) {
+                indexed_builtin_loops[t - NPY_BYTE][k] = ufunc->functions[j];
+            }
+        }
+    }
+    return 0;
+}
+
+#define INDEXED_LOOPS(TYPE) {                                       \
+        &TYPE##_add_indexed, &TYPE##_subtract_indexed,              \
+        &TYPE##_multiply_indexed, &TYPE##_maximum_indexed,          \
+        &TYPE##_minimum_indexed}
+
+static PyUFuncGenericFunction
+indexed_loop(PyUFuncGenericFunction innerloop, int type_num)
+{
+    static PyUFuncGenericFunction loops[][NPY_INDEXED_KINDS] = {
+        INDEXED_LOOPS(BYTE), INDEXED_LOOPS(UBYTE),
+        INDEXED_LOOPS(SHORT), INDEXED_LOOPS(USHORT),
+        INDEXED_LOOPS(INT), INDEXED_LOOPS(UINT),
+        INDEXED_LOOPS(LONG), INDEXED_LOOPS(ULONG),
+        INDEXED_LOOPS(LONGLONG), INDEXED_LOOPS(ULONGLONG),
+        INDEXED_LOOPS(FLOAT), INDEXED_LOOPS(DOUBLE),
+        INDEXED_LOOPS(LONGDOUBLE)};
+    int k;
+
+    if (innerloop == NULL || type_num < NPY_BYTE ||
+            type_num > NPY_LONGDOUBLE) {
+        return NULL;
+    }
+    for (k = 0; k < NPY_INDEXED_KINDS; k++) {
+        if (innerloop == indexed_builtin_loops[type_num - NPY_BYTE][k]) {
+            return loops[type_num - NPY_BYTE][k];
+        }
+    }
+    return NULL;
+}
+
+#undef INDEXED_LOOPS
+#undef NPY_INDEXED_KINDS
+#undef NPY_INDEXED_TYPES
+
+/*
+ * ufunc.at of a binary ufunc with an indexed loop, for a 1-d array indexed
+ * by a single integer array and values that need no broadcasting. The
+ * values are cast once up front and the loop applies a whole inner loop
+ * of indices from the map iterator at a time, instead of a buffered inner
+ * loop call for every item. Returns 1 if the call does not qualify, 0 on
+ * success and -1 on error.
+ */
+static int
+ufunc_at_indexed(PyUFuncGenericFunction innerloop,
+                 PyArrayMapIterObject *iter, PyArrayObject *op2_array,
+                 PyArray_Descr **dtypes)
+{
+    PyArrayObject *op1_array = iter->array;
+    PyArrayObject *values;
+    PyUFuncGenericFunction loop;
+    npy_intp *countptr;
+    char *args[3];
+    npy_intp dims[2], steps[3];
+    NPY_BEGIN_THREADS_DEF;
+
+    if (iter->size == 0 || iter->numiter != 1 || iter->subspace != NULL ||
+            iter->needs_api || PyArray_NDIM(op1_array) != 1 ||
+            !PyArray_ISALIGNED(op1_array) || !PyArray_ISWRITEABLE(op1_array) ||
+            !PyArray_ISNBO(PyArray_DESCR(op1_array)->byteorder) ||
+            !PyArray_EquivTypes(PyArray_DESCR(op1_array), dtypes[0]) ||
+            !PyArray_EquivTypes(dtypes[0], dtypes[1]) ||
+            !PyArray_EquivTypes(dtypes[0], dtypes[2])) {
+        return 1;
+    }
+    if (PyArray_SIZE(op2_array) != 1 && PyArray_SIZE(op2_array) != iter->size) {
+        return 1;
+    }
+    loop = indexed_loop(innerloop, dtypes[0]->type_num);
+    if (loop == NULL) {
+        return 1;
+    }
+
+    /* Unsafe casting, like the buffered loop */
+    Py_INCREF(dtypes[1]);
+    values = (PyArrayObject *)PyArray_FromArray(op2_array, dtypes[1],
+                                    NPY_ARRAY_CARRAY_RO | NPY_ARRAY_FORCECAST);
+    if (values == NULL) {
+        return -1;
+    }
+
+    args[2] = PyArray_BYTES(values);
+    dims[1] = PyArray_DIM(op1_array, 0);
+    steps[0] = PyArray_STRIDE(op1_array, 0);
+    steps[2] = PyArray_SIZE(values) == 1 ? 0 : PyArray_ITEMSIZE(values);
+    countptr = NpyIter_GetInnerLoopSizePtr(iter->outer);
+
+    NPY_BEGIN_THREADS_THRESHOLDED(iter->size);
+    /* The outer iterator was reset by the map iterator, in C order */
+    do {
+        args[0] = PyArray_BYTES(op1_array);
+        args[1] = iter->outer_ptrs[0];
+        steps[1] = iter->outer_strides[0];
+        dims[0] = *countptr;
+        loop(args, dims, steps, NULL);
+        args[2] += dims[0] * steps[2];
+    } while (iter->outer_next(iter->outer));
+    NPY_END_THREADS;
+
+    Py_DECREF(values);
+    return 0;
+}
+
 static NPY_INLINE PyArrayObject *
 new_array_op(PyArrayObject *op_array, char *data)
 {
@@ -5715,6 +6250,22 @@ ufunc_at(PyUFuncObject *ufunc, PyObject *args)
         goto fail;
     }
 
+    if (iter2 != NULL && !needs_api) {
+        int res = ufunc_at_indexed(innerloop, iter, op2_array, dtypes);
+        if (res < 0) {
+            goto fail;
+        }
+        else if (res == 0) {
+            Py_DECREF(op2_array);
+            Py_DECREF(iter);
+            Py_DECREF(iter2);
+            for (i = 0; i < 3; i++) {
+                Py_XDECREF(dtypes[i]);
+            }
+            Py_RETURN_NONE;
+        }
+    }
+
     Py_INCREF(PyArray_DESCR(op1_array));
     array_operands[0] = new_array_op(op1_array, iter->dataptr);
     if (iter2 != NULL) {
@@ -12,6 +12,14 @@ ufunc_seterr(PyObject *NPY_UNUSED(dummy), PyObject *args);
 NPY_NO_EXPORT const char*
 ufunc_get_name_cstr(PyUFuncObject *ufunc);
 
+/* records the inner loops of the builtin ufuncs that ufunc.at can index */
+NPY_NO_EXPORT int
+init_indexed_loops(PyObject *d);
+
+/* records the inner loops of add, which reductions may regroup */
+NPY_NO_EXPORT int
+init_reduce_add_loops(PyObject *d);
+
 /* strings from umathmodule.c that are interned on umath import */
 NPY_VISIBILITY_HIDDEN extern PyObject *npy_um_str_out;
 NPY_VISIBILITY_HIDDEN extern PyObject *npy_um_str_where;
@@ -30,6 +30,7 @@
 
 #include "numpy/npy_math.h"
 #include "number.h"
+#include "ufunc_object.h"
 
 static PyUFuncGenericFunction pyfunc_functions[] = {PyUFunc_On_Om};
 
@@ -325,6 +326,13 @@ int initumath(PyObject *m)
     PyDict_SetItemString(d, "conj", s);
     PyDict_SetItemString(d, "mod", s2);
 
+    if (init_indexed_loops(d) < 0) {
+        return -1;
+    }
+    if (init_reduce_add_loops(d) < 0) {
+        return -1;
+    }
+
     if (intern_strings() < 0) {
         PyErr_SetString(PyExc_RuntimeError,
            "cannot intern umath strings while initializing _multiarray_umath.");
@@ -29,4 +29,29 @@
 #define npyv_cvt_b32_f32(A) ((npyv_b32) A)
 #define npyv_cvt_b64_f64(A) ((npyv_b64) A)
 
+// convert double precision to single precision and vice versa
+NPY_FINLINE npyv_f32 npyv_pack_f32_f64(npyv_f64 a, npyv_f64 b)
+{ return vec_float2(a, b); }
+
+NPY_FINLINE npyv_f64x2 npyv_expand_f64_f32(npyv_f32 a)
+{
+    npyv_f64x2 r;
+    r.val[0] = vec_doubleh(a);
+    r.val[1] = vec_doublel(a);
+    return r;
+}
+
+// expand unsigned 16-bit lanes to 32-bit and narrow them back (truncating)
+NPY_FINLINE npyv_u32x2 npyv_expand_u32_u16(npyv_u16 a)
+{
+    const npyv_u16 z = npyv_zero_u16();
+    npyv_u32x2 r;
+    r.val[0] = (npyv_u32)vec_mergeh(a, z);
+    r.val[1] = (npyv_u32)vec_mergel(a, z);
+    return r;
+}
+
+NPY_FINLINE npyv_u16 npyv_pack_u16_u32(npyv_u32 a, npyv_u32 b)
+{ return vec_pack(a, b); }
+
 #endif // _NPY_SIMD_VSX_CVT_H
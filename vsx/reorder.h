@@ -62,4 +62,19 @@ NPYV_IMPL_VSX_COMBINE_ZIP(npyv_s64, s64)
 NPYV_IMPL_VSX_COMBINE_ZIP(npyv_f32, f32)
 NPYV_IMPL_VSX_COMBINE_ZIP(npyv_f64, f64)
 
+// reverse the byte order of each lane
+#define NPYV_IMPL_VSX_BSWAP(T_VEC, SFX, ...)                     \
+    NPY_FINLINE T_VEC npyv_bswap_##SFX(T_VEC a)                  \
+    {                                                            \
+        const npyv_u8 idx = npyv_set_u8(__VA_ARGS__);            \
+        return (T_VEC)vec_perm((npyv_u8)a, (npyv_u8)a, idx);     \
+    }
+
+NPYV_IMPL_VSX_BSWAP(npyv_u16, u16, 1,0, 3,2, 5,4, 7,6, 9,8, 11,10, 13,12, 15,14)
+NPYV_IMPL_VSX_BSWAP(npyv_u32, u32, 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12)
+NPYV_IMPL_VSX_BSWAP(npyv_u64, u64, 7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8)
+#define npyv_bswap_s16(A) ((npyv_s16)npyv_bswap_u16((npyv_u16)(A)))
+#define npyv_bswap_s32(A) ((npyv_s32)npyv_bswap_u32((npyv_u32)(A)))
+#define npyv_bswap_s64(A) ((npyv_s64)npyv_bswap_u64((npyv_u64)(A)))
+
 #endif // _NPY_SIMD_VSX_REORDER_H